@@ -0,0 +1,19 @@
+#include <benchmark/benchmark.h>
+
+#include "bot.hpp"
+#include "fixtures.hpp"
+
+/**
+ * @brief Measures a single decision of a Bot
+ * @param state The benchmark state, range 0 is the number of players and range 1 the number of points in each trail
+ */
+static void BM_BotMakeMove(benchmark::State &state) {
+	auto &curvers = Bench::setupCurvers(state.range(0), state.range(1));
+	for (auto _ : state) {
+		for (auto &c : curvers) {
+			Bot::makeMove(*c);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * curvers.size());
+}
+BENCHMARK(BM_BotMakeMove)->ArgsProduct({{2, 8, 32}, {512, 4096}});
@@ -0,0 +1,222 @@
+#include "checks.hpp"
+
+#include <QDebug>
+#include <QSGFlatColorMaterial>
+#include <QtMath>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+#include "fixtures.hpp"
+#include "intersection.hpp"
+#include "itemfactory.hpp"
+#include "segment.hpp"
+
+// the number of points in the trail of the pop checks, spanning several chunks of bounding boxes
+#define POP_TRAIL_LENGTH 200
+// the half length of the probe lines crossing the trail
+#define PROBE_LENGTH 10.0
+// the number of random pairs of a line and an edge that all intersection kernels must agree on
+#define KERNEL_RANDOM_CASES 4096
+// the number of edges that every kernel checks at once, enough for a full AVX2 batch followed by a scalar remainder
+#define KERNEL_EDGES 12
+// the number of units in the last place that the epsilon boundary cases are moved to either side
+#define KERNEL_BOUNDARY_ULPS 4
+// the number of points in the trail that the kernels check ranges of
+#define KERNEL_TRAIL_LENGTH 1024
+// the number of random ranges of the trail that the kernels check
+#define KERNEL_TRAIL_QUERIES 4096
+// the length of the lines that the ranges of the trail are checked against
+#define KERNEL_QUERY_LENGTH 100.0
+
+/**
+ * @brief Checks that a Segment answers collision queries correctly after points were popped and new ones appended
+ *
+ * Every amount of popped points is tried, so every position of the oldest remaining edge relative to the chunk boundaries is covered.
+ * The reference is a Segment that never popped anything, queried for the remaining edges only.
+ * @return \c True, iif all queries agree
+ */
+static bool checkSegmentPop() {
+	std::mt19937 rng(Bench::seed);
+	const auto trail = Bench::makeTrail(rng, POP_TRAIL_LENGTH);
+	// lines crossing the trail at every point, which hit the edges around it
+	std::vector<std::pair<QPointF, QPointF>> probes;
+	for (const auto &p : trail) {
+		const QPointF normal = PROBE_LENGTH * QPointF(-sin(p.angle), cos(p.angle));
+		probes.emplace_back(p.pos - normal, p.pos + normal);
+	}
+	QSGFlatColorMaterial material;
+	const size_t half = trail.size() / 2;
+	for (size_t popped = 1; popped < 2 * half; ++popped) {
+		Segment reference(nullptr, &material, 4);
+		Segment segment(nullptr, &material, 4);
+		for (size_t i = 0; i < half; ++i) {
+			reference.appendPoint(trail[i].pos, trail[i].angle);
+			segment.appendPoint(trail[i].pos, trail[i].angle);
+		}
+		segment.popPoints(popped);
+		for (size_t i = half; i < trail.size(); ++i) {
+			reference.appendPoint(trail[i].pos, trail[i].angle);
+			segment.appendPoint(trail[i].pos, trail[i].angle);
+		}
+		for (const auto &[a, b] : probes) {
+			if (segment.checkForIntersection(a, b) != reference.checkForIntersection(a, b, popped + 2, std::numeric_limits<size_t>::max())) {
+				qCritical() << "Segment disagrees with the reference after popping" << popped << "points, probe" << a << b;
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Moves a coordinate by some units in the last place of the given floating point type
+ * @param v The coordinate
+ * @param ulps The number of units, negative values move towards negative infinity
+ * @return The moved coordinate
+ */
+template <typename T>
+static double nudge(const T v, const int ulps) {
+	T result = v;
+	for (int i = 0; i < std::abs(ulps); ++i) {
+		result = std::nextafter(result, ulps < 0 ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity());
+	}
+	return result;
+}
+
+/**
+ * @brief Generates pairs of a line and an edge, that the intersection kernels are checked with
+ *
+ * Besides random pairs this contains the degenerate cases, where the results are most sensitive to rounding:
+ * Collinear, parallel and touching edges, edges and lines of zero length and intersections right at the epsilon boundaries.
+ * @return The start and end point of the line followed by the start and end point of the edge
+ */
+static std::vector<std::array<QPointF, 4>> makeKernelCases() {
+	std::mt19937 rng(Bench::seed);
+	std::uniform_real_distribution<double> coord(0, 100);
+	std::uniform_real_distribution<double> unit(0, 1);
+	const auto point = [&]() { return QPointF(coord(rng), coord(rng)); };
+	std::vector<std::array<QPointF, 4>> cases;
+	for (int i = 0; i < KERNEL_RANDOM_CASES; ++i) {
+		cases.push_back({point(), point(), point(), point()});
+	}
+	for (int i = 0; i < KERNEL_RANDOM_CASES / 16; ++i) {
+		const QPointF a = point(), b = point(), side = point();
+		const QPointF on = a + unit(rng) * (b - a);
+		const QPointF normal = QPointF(a.y() - b.y(), b.x() - a.x()) / std::hypot(b.x() - a.x(), b.y() - a.y());
+		// collinear and overlapping
+		cases.push_back({a, b, a + 0.25 * (b - a), a + 1.5 * (b - a)});
+		// parallel, right at the tolerance
+		cases.push_back({a, b, a + Intersection::epsilon * normal, b + Intersection::epsilon * normal});
+		// touching the line inside of it and at its end
+		cases.push_back({a, b, on, side});
+		cases.push_back({a, b, b, side});
+		// zero length
+		cases.push_back({a, b, on, on});
+		cases.push_back({on, on, a, b});
+	}
+	// these coordinates are exact in single precision, so every implementation computes the intersection locations exactly
+	const double x = 37.25, y = 51.5, epsilon = Intersection::epsilon;
+	for (int ulps = -KERNEL_BOUNDARY_ULPS; ulps <= KERNEL_BOUNDARY_ULPS; ++ulps) {
+		// the line crosses the extension of the edge just behind its end, which is compared in double precision
+		cases.push_back({QPointF(x, 0), QPointF(x, 100), QPointF(x - 10, y), QPointF(nudge(x - epsilon, ulps), y)});
+		cases.push_back({QPointF(x, 0), QPointF(x, 100), QPointF(x + 10, y), QPointF(nudge(x + epsilon, ulps), y)});
+		cases.push_back({QPointF(0, y), QPointF(100, y), QPointF(x, y - 10), QPointF(x, nudge(y - epsilon, ulps))});
+		cases.push_back({QPointF(0, y), QPointF(100, y), QPointF(x, y + 10), QPointF(x, nudge(y + epsilon, ulps))});
+		// the edge crosses the extension of the line just behind its end, which is compared in single precision
+		cases.push_back({QPointF(0, y), QPointF(x, y), QPointF(nudge(static_cast<float>(x + epsilon), ulps), 0), QPointF(nudge(static_cast<float>(x + epsilon), ulps), 100)});
+		cases.push_back({QPointF(x, y), QPointF(100, y), QPointF(nudge(static_cast<float>(x - epsilon), ulps), 0), QPointF(nudge(static_cast<float>(x - epsilon), ulps), 100)});
+		cases.push_back({QPointF(x, 0), QPointF(x, y), QPointF(0, nudge(static_cast<float>(y + epsilon), ulps)), QPointF(100, nudge(static_cast<float>(y + epsilon), ulps))});
+		cases.push_back({QPointF(x, y), QPointF(x, 100), QPointF(0, nudge(static_cast<float>(y - epsilon), ulps)), QPointF(100, nudge(static_cast<float>(y - epsilon), ulps))});
+	}
+	return cases;
+}
+
+/**
+ * @brief Checks that every intersection kernel supported by this CPU returns the same results as the scalar reference implementation
+ *
+ * Every case is placed at every position of a batch, where all other edges touch a point that is not a number and thus never collide.
+ * This way a single lane that disagrees cannot be hidden by another edge.
+ * Afterwards random ranges of a trail are compared, where every edge is a real one.
+ * @return \c True, iif all kernels agree
+ */
+static bool checkIntersectionKernels() {
+	const auto kernels = Intersection::supportedKernels();
+	std::vector<double> xs(KERNEL_EDGES + 2), ys(KERNEL_EDGES + 2);
+	for (const auto &[a, b, c, d] : makeKernelCases()) {
+		const auto line = Intersection::makeLine(a, b);
+		for (size_t edge = 2; edge < xs.size(); ++edge) {
+			std::ranges::fill(xs, std::numeric_limits<double>::quiet_NaN());
+			std::ranges::fill(ys, std::numeric_limits<double>::quiet_NaN());
+			xs[edge - 2] = c.x();
+			ys[edge - 2] = c.y();
+			xs[edge] = d.x();
+			ys[edge] = d.y();
+			const bool expected = kernels.front().check(line, xs.data(), ys.data(), edge, edge);
+			for (const auto &kernel : kernels) {
+				if (kernel.check(line, xs.data(), ys.data(), 2, xs.size() - 1) != expected) {
+					qCritical() << "The" << kernel.name << "intersection kernel disagrees with the scalar one at edge" << edge << "for the line" << a << b << "and the edge" << c << d;
+					return false;
+				}
+			}
+		}
+	}
+
+	std::mt19937 rng(Bench::seed);
+	xs.clear();
+	ys.clear();
+	for (const auto &p : Bench::makeTrail(rng, KERNEL_TRAIL_LENGTH)) {
+		xs.push_back(p.pos.x());
+		ys.push_back(p.pos.y());
+	}
+	std::uniform_int_distribution<size_t> index(2, xs.size() - 1);
+	for (const auto &[a, b] : Bench::makeQueries(rng, KERNEL_TRAIL_QUERIES, KERNEL_QUERY_LENGTH)) {
+		const auto line = Intersection::makeLine(a, b);
+		const size_t first = index(rng), last = index(rng);
+		const size_t begin = std::min(first, last), end = std::max(first, last);
+		const bool expected = kernels.front().check(line, xs.data(), ys.data(), begin, end);
+		for (const auto &kernel : kernels) {
+			if (kernel.check(line, xs.data(), ys.data(), begin, end) != expected) {
+				qCritical() << "The" << kernel.name << "intersection kernel disagrees with the scalar one for the edges" << begin << "to" << end << "and the line" << a << b;
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Checks that the effect of an Item ends on a Client, which integrates Item events but never simulates a tick itself
+ * @return \c True, iif the effect started with the trigger and ended with the played back tick
+ */
+static bool checkClientItemEffect() {
+	Curver &curver = *Bench::setupCurvers(1, 0).front();
+	const float velocity = curver.velocity;
+	Random random;
+	ItemFactory factory(nullptr, &random);
+	const quint64 triggerTick = 100;
+	factory.follow(triggerTick);
+	// the speed item, collected by the only Curver
+	factory.integrateItem(true, 1, 0, QPointF(100, 100), Item::AllowedUsers::ALLOW_COLLECTOR, -1);
+	factory.integrateItem(false, 1, 0, QPointF(), Item::AllowedUsers::ALLOW_COLLECTOR, 0);
+	factory.follow(triggerTick + 1);
+	if (curver.velocity == velocity) {
+		qCritical() << "The Item integrated from the Server had no effect";
+		return false;
+	}
+	factory.follow(triggerTick + Settings::get()->msecsToTicks(60000));
+	if (curver.velocity != velocity) {
+		qCritical() << "The effect of the Item integrated from the Server did not end on the Client";
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Runs every consistency check
+ * @return \c True, iif all checks passed
+ */
+bool Bench::runChecks() {
+	return checkSegmentPop() && checkIntersectionKernels() && checkClientItemEffect();
+}
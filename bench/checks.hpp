@@ -0,0 +1,10 @@
+#pragma once
+
+/**
+ * @brief Consistency checks of the optimized code paths, run before any benchmark
+ *
+ * A benchmark of wrong results is worthless, so the suite refuses to run if any check fails.
+ */
+namespace Bench {
+bool runChecks();
+}
@@ -0,0 +1,72 @@
+#include <QSGFlatColorMaterial>
+#include <benchmark/benchmark.h>
+
+#include "fixtures.hpp"
+#include "segment.hpp"
+#include "spatialgrid.hpp"
+
+// number of precomputed query lines that every benchmark cycles through
+#define QUERY_COUNT 1024
+// the distance a Curver moves in one tick, i.e. the length of the line checked every tick
+#define QUERY_LENGTH 2.0
+
+/**
+ * @brief Measures a collision query against a single Segment, without the help of a SpatialGrid
+ * @param state The benchmark state, range 0 is the number of points in the trail
+ */
+static void BM_SegmentCheckForIntersection(benchmark::State &state) {
+	std::mt19937 rng(Bench::seed);
+	QSGFlatColorMaterial material;
+	Segment segment(nullptr, &material, 4);
+	for (const auto &p : Bench::makeTrail(rng, state.range(0))) {
+		segment.appendPoint(p.pos, p.angle);
+	}
+	const auto queries = Bench::makeQueries(rng, QUERY_COUNT, QUERY_LENGTH);
+	size_t i = 0;
+	for (auto _ : state) {
+		const auto &[a, b] = queries[i++ % queries.size()];
+		benchmark::DoNotOptimize(segment.checkForIntersection(a, b));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SegmentCheckForIntersection)->RangeMultiplier(4)->Range(256, 65536);
+
+/**
+ * @brief Measures a collision query against a single Segment through its SpatialGrid
+ * @param state The benchmark state, range 0 is the number of points in the trail
+ */
+static void BM_GridCheckForIntersection(benchmark::State &state) {
+	std::mt19937 rng(Bench::seed);
+	QSGFlatColorMaterial material;
+	SpatialGrid grid;
+	grid.reset(Settings::get()->getDimension());
+	Segment segment(nullptr, &material, 4, &grid);
+	for (const auto &p : Bench::makeTrail(rng, state.range(0))) {
+		segment.appendPoint(p.pos, p.angle);
+	}
+	const auto queries = Bench::makeQueries(rng, QUERY_COUNT, QUERY_LENGTH);
+	size_t i = 0;
+	for (auto _ : state) {
+		const auto &[a, b] = queries[i++ % queries.size()];
+		benchmark::DoNotOptimize(grid.checkForIntersection(a, b));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GridCheckForIntersection)->RangeMultiplier(4)->Range(256, 65536);
+
+/**
+ * @brief Measures the collision query that every Curver performs once per tick
+ * @param state The benchmark state, range 0 is the number of players and range 1 the number of points in each trail
+ */
+static void BM_CurverCheckForIntersection(benchmark::State &state) {
+	auto &curvers = Bench::setupCurvers(state.range(0), state.range(1));
+	std::mt19937 rng(Bench::seed + 1);
+	const auto queries = Bench::makeQueries(rng, QUERY_COUNT, QUERY_LENGTH);
+	size_t i = 0;
+	for (auto _ : state) {
+		const auto &[a, b] = queries[i++ % queries.size()];
+		benchmark::DoNotOptimize(curvers.front()->checkForIntersection(curvers, a, b));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CurverCheckForIntersection)->ArgsProduct({{2, 8, 32}, {512, 4096, 32768}});
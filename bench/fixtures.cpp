@@ -0,0 +1,91 @@
+#include "fixtures.hpp"
+
+#include <QtMath>
+
+#include "models/playermodel.hpp"
+#include "settings.hpp"
+
+// distance covered in one tick at the default velocity
+#define TRAIL_STEP 2.0
+// maximum change of direction per step in radian
+#define TRAIL_MAX_TURN 0.2
+// distance that trails keep from the wall
+#define TRAIL_WALL_MARGIN 20.0
+
+/**
+ * @brief Generates a random walk through the arena that resembles the trail of a Curver
+ *
+ * The walk turns around when it gets close to the wall, so long trails cross themselves many times, just like in a real game.
+ * @param rng The random generator to use
+ * @param length The number of points in the trail
+ * @return The trail
+ */
+std::vector<Bench::TrailPoint> Bench::makeTrail(std::mt19937 &rng, const size_t length) {
+	const QPoint dimension = Settings::get()->getDimension();
+	std::uniform_real_distribution<double> unit(0, 1);
+	const auto inside = [&](const QPointF p) { return p.x() > TRAIL_WALL_MARGIN && p.y() > TRAIL_WALL_MARGIN && p.x() < dimension.x() - TRAIL_WALL_MARGIN && p.y() < dimension.y() - TRAIL_WALL_MARGIN; };
+
+	QPointF pos(dimension.x() * (0.25 + 0.5 * unit(rng)), dimension.y() * (0.25 + 0.5 * unit(rng)));
+	double angle = 2 * M_PI * unit(rng);
+	std::vector<TrailPoint> result;
+	result.reserve(length);
+	while (result.size() < length) {
+		angle += (unit(rng) - 0.5) * TRAIL_MAX_TURN;
+		QPointF next = pos + TRAIL_STEP * QPointF(cos(angle), sin(angle));
+		if (!inside(next)) {
+			angle += M_PI;
+			next = pos + TRAIL_STEP * QPointF(cos(angle), sin(angle));
+		}
+		pos = next;
+		result.push_back({pos, static_cast<float>(angle)});
+	}
+	return result;
+}
+
+/**
+ * @brief Generates random query lines in the arena
+ * @param rng The random generator to use
+ * @param count The number of lines
+ * @param length The length of every line
+ * @return The start and end point of every line
+ */
+std::vector<std::pair<QPointF, QPointF>> Bench::makeQueries(std::mt19937 &rng, const size_t count, const double length) {
+	const QPoint dimension = Settings::get()->getDimension();
+	std::uniform_real_distribution<double> unit(0, 1);
+	std::vector<std::pair<QPointF, QPointF>> result;
+	result.reserve(count);
+	for (size_t i = 0; i < count; ++i) {
+		const QPointF a(dimension.x() * unit(rng), dimension.y() * unit(rng));
+		const double angle = 2 * M_PI * unit(rng);
+		result.emplace_back(a, a + length * QPointF(cos(angle), sin(angle)));
+	}
+	return result;
+}
+
+/**
+ * @brief Replaces all players in the PlayerModel with Curvers that already have a trail
+ *
+ * The Curvers are not rendered, so only the game state is measured.
+ * @param count The number of Curvers
+ * @param trailLength The number of points in the trail of every Curver
+ * @return All Curvers
+ */
+std::vector<std::unique_ptr<Curver>> &Bench::setupCurvers(const size_t count, const size_t trailLength) {
+	static Random random;
+	random.seed(seed);
+	PlayerModel *model = PlayerModel::get();
+	model->setRootNode(nullptr);
+	model->setRandom(&random);
+	auto &curvers = model->getCurvers();
+	while (!curvers.empty()) {
+		model->removePlayer(0);
+	}
+	std::mt19937 rng(seed);
+	for (size_t i = 0; i < count; ++i) {
+		model->appendPlayer();
+		for (const auto &p : makeTrail(rng, trailLength)) {
+			curvers.back()->appendPoint(p.pos, false);
+		}
+	}
+	return curvers;
+}
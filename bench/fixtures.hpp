@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QPointF>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "curver.hpp"
+
+/**
+ * @brief Deterministic test data shared by all benchmarks
+ *
+ * Everything is generated from a fixed seed, so every run measures exactly the same workload.
+ */
+namespace Bench {
+/**
+ * @brief The seed of every random generator in the benchmarks
+ */
+constexpr std::mt19937::result_type seed = 1337;
+
+/**
+ * @brief A point of a trail together with the angle that the Curver had when it reached the point
+ */
+struct TrailPoint {
+	/**
+	 * @brief The position
+	 */
+	QPointF pos;
+	/**
+	 * @brief The angle of movement
+	 */
+	float angle;
+};
+
+std::vector<TrailPoint> makeTrail(std::mt19937 &rng, const size_t length);
+std::vector<std::pair<QPointF, QPointF>> makeQueries(std::mt19937 &rng, const size_t count, const double length);
+std::vector<std::unique_ptr<Curver>> &setupCurvers(const size_t count, const size_t trailLength);
+}
@@ -0,0 +1,52 @@
+#include <QSGFlatColorMaterial>
+#include <QSGNode>
+#include <benchmark/benchmark.h>
+
+#include "fixtures.hpp"
+#include "segment.hpp"
+#include "segmentnode.hpp"
+
+/**
+ * @brief Measures appending points to a Segment
+ *
+ * Every iteration builds a complete trail, so the cost of growing all buffers is included.
+ * @param state The benchmark state, range 0 is the number of points in the trail and range 1 whether the Segment is rendered
+ */
+static void BM_SegmentAppendPoint(benchmark::State &state) {
+	std::mt19937 rng(Bench::seed);
+	const auto trail = Bench::makeTrail(rng, state.range(0));
+	QSGNode root;
+	QSGFlatColorMaterial material;
+	SpatialGrid grid;
+	grid.reset(Settings::get()->getDimension());
+	for (auto _ : state) {
+		Segment segment(state.range(1) ? &root : nullptr, &material, 4, &grid);
+		for (const auto &p : trail) {
+			segment.appendPoint(p.pos, p.angle);
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * trail.size());
+}
+BENCHMARK(BM_SegmentAppendPoint)->ArgsProduct({{1024, 16384}, {0, 1}});
+
+/**
+ * @brief Measures rewriting the whole geometry of a Segment, as it happens on every reallocation
+ * @param state The benchmark state, range 0 is the number of points in the trail
+ */
+static void BM_SegmentNodeUpdate(benchmark::State &state) {
+	std::mt19937 rng(Bench::seed);
+	std::vector<QPointF> pos;
+	for (const auto &p : Bench::makeTrail(rng, state.range(0))) {
+		pos.push_back(p.pos);
+	}
+	QSGNode root;
+	QSGFlatColorMaterial material;
+	SegmentNode node(&root, &material, 4);
+	for (auto _ : state) {
+		node.update(pos, 0);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * pos.size());
+}
+BENCHMARK(BM_SegmentNodeUpdate)->RangeMultiplier(4)->Range(256, 65536);
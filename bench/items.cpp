@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+
+#include "fixtures.hpp"
+#include "itemgrid.hpp"
+#include "items/item.hpp"
+#include "settings.hpp"
+
+// number of precomputed Curver heads that every benchmark cycles through
+#define QUERY_COUNT 1024
+
+/**
+ * @brief Spawns Item instances at random locations like ItemFactory does, without rendering them
+ * @param rng The random generator to use
+ * @param count The number of Item instances
+ * @return The Item instances
+ */
+static std::vector<std::unique_ptr<Item>> makeItems(std::mt19937 &rng, const size_t count) {
+	const QPoint dimension = Settings::get()->getDimension();
+	std::uniform_real_distribution<double> x(0, dimension.x());
+	std::uniform_real_distribution<double> y(0, dimension.y());
+	std::vector<std::unique_ptr<Item>> result;
+	for (size_t i = 0; i < count; ++i) {
+		result.push_back(std::make_unique<Item>(nullptr, "", Item::AllowedUsers::ALLOW_ALL, QPointF(x(rng), y(rng)), nullptr));
+	}
+	return result;
+}
+
+/**
+ * @brief Generates random Curver heads
+ * @param rng The random generator to use
+ * @return The positions of the heads
+ */
+static std::vector<QPointF> makeHeads(std::mt19937 &rng) {
+	std::vector<QPointF> result;
+	for (const auto &[a, b] : Bench::makeQueries(rng, QUERY_COUNT, 0)) {
+		result.push_back(a);
+	}
+	return result;
+}
+
+/**
+ * @brief Measures finding the Item in range of a Curver head by testing every Item
+ * @param state The benchmark state, range 0 is the number of Item instances on the field
+ */
+static void BM_ItemsInRangeLinear(benchmark::State &state) {
+	std::mt19937 rng(Bench::seed);
+	const auto items = makeItems(rng, state.range(0));
+	const auto heads = makeHeads(rng);
+	size_t i = 0;
+	for (auto _ : state) {
+		const QPointF head = heads[i++ % heads.size()];
+		benchmark::DoNotOptimize(std::ranges::find_if(items, [head](const auto &item) { return item->isInRange(head); }));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ItemsInRangeLinear)->RangeMultiplier(4)->Range(16, 4096);
+
+/**
+ * @brief Measures finding the Item in range of a Curver head through an ItemGrid
+ * @param state The benchmark state, range 0 is the number of Item instances on the field
+ */
+static void BM_ItemGridItemInRange(benchmark::State &state) {
+	std::mt19937 rng(Bench::seed);
+	const auto items = makeItems(rng, state.range(0));
+	ItemGrid grid;
+	grid.reset(Settings::get()->getDimension());
+	std::ranges::for_each(items, [&grid](const auto &item) { grid.insert(item.get()); });
+	const auto heads = makeHeads(rng);
+	size_t i = 0;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(grid.itemInRange(heads[i++ % heads.size()]));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ItemGridItemInRange)->RangeMultiplier(4)->Range(16, 4096);
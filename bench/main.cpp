@@ -0,0 +1,35 @@
+#include <QGuiApplication>
+#include <benchmark/benchmark.h>
+
+#include "checks.hpp"
+#include "intersection.hpp"
+#include "version.hpp"
+
+/**
+ * @brief Runs all benchmarks
+ *
+ * The consistency checks run first, see Bench::runChecks().
+ * Accepts the usual Google Benchmark options, e.g. \c --benchmark_format=json or \c --benchmark_out=results.json for machine-readable results.
+ * @param argc The number of arguments
+ * @param argv The arguments
+ * @return The exit code
+ */
+int main(int argc, char *argv[]) {
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+		return 1;
+	}
+	// the benchmarks only measure the game state, nothing is ever rendered
+	qputenv("QT_QPA_PLATFORM", "offscreen");
+	QGuiApplication app(argc, argv);
+	if (!Bench::runChecks()) {
+		return 1;
+	}
+
+	// record what was measured, so that results of different builds and machines can be told apart
+	benchmark::AddCustomContext("quickcurver_version", Version::version_string());
+	benchmark::AddCustomContext("intersection_kernel", Intersection::kernelName());
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+
+#include "fixtures.hpp"
+#include "network/network.hpp"
+
+// the number of ticks between the acknowledged frame and the sent frame
+#define ACK_DISTANCE 4
+
+/**
+ * @brief Creates the ServerCurverData packet of a game with the given number of players
+ *
+ * The trails of all players are simulated, so that the deltas between frames are realistic.
+ * @param players The number of players
+ * @param delta Whether to encode the packet relative to an earlier frame
+ * @return The packet
+ */
+static Packet::ServerCurverData makeCurverData(const size_t players, const bool delta) {
+	std::mt19937 rng(Bench::seed);
+	Packet::CurverFrame base(1);
+	Packet::CurverFrame frame(1 + ACK_DISTANCE);
+	for (size_t i = 0; i < players; ++i) {
+		const auto trail = Bench::makeTrail(rng, 1 + ACK_DISTANCE);
+		base.pos.push_back(Packet::quantize(trail.front().pos));
+		frame.pos.push_back(Packet::quantize(trail.back().pos));
+	}
+	Packet::ServerCurverData packet;
+	packet.fill(frame, std::vector<bool>(players), delta ? &base : nullptr);
+	return packet;
+}
+
+/**
+ * @brief Measures serializing the packet that the Server broadcasts every tick
+ * @param state The benchmark state, range 0 is the number of players and range 1 whether the positions are delta encoded
+ */
+static void BM_ServerCurverDataSerialize(benchmark::State &state) {
+	const auto packet = makeCurverData(state.range(0), state.range(1));
+	size_t bytes = 0;
+	for (auto _ : state) {
+		const QByteArray block = packet.toByteArray();
+		bytes += block.size();
+		benchmark::DoNotOptimize(block.constData());
+	}
+	state.SetBytesProcessed(bytes);
+	state.counters["packet_bytes"] = packet.toByteArray().size();
+}
+BENCHMARK(BM_ServerCurverDataSerialize)->ArgsProduct({{2, 8, 32, 128}, {0, 1}});
+
+/**
+ * @brief Measures parsing the packet that the Server broadcasts every tick
+ * @param state The benchmark state, range 0 is the number of players and range 1 whether the positions are delta encoded
+ */
+static void BM_ServerCurverDataParse(benchmark::State &state) {
+	const QByteArray block = makeCurverData(state.range(0), state.range(1)).toByteArray();
+	Packet::PacketPool pool;
+	for (auto _ : state) {
+		QDataStream in(block);
+		in.startTransaction();
+		auto packet = Packet::AbstractPacket::receivePacket(in, InstanceType::Server, pool);
+		benchmark::DoNotOptimize(in.commitTransaction());
+		benchmark::DoNotOptimize(packet);
+	}
+	state.SetBytesProcessed(state.iterations() * block.size());
+}
+BENCHMARK(BM_ServerCurverDataParse)->ArgsProduct({{2, 8, 32, 128}, {0, 1}});
+
+/**
+ * @brief Measures serializing and parsing the PlayerModel, which is sent whenever a player changes
+ * @param state The benchmark state, range 0 is the number of players
+ */
+static void BM_ServerPlayerModelRoundTrip(benchmark::State &state) {
+	Bench::setupCurvers(state.range(0), 0);
+	Packet::ServerPlayerModel packet;
+	packet.fill();
+	Packet::PacketPool pool;
+	size_t bytes = 0;
+	for (auto _ : state) {
+		const QByteArray block = packet.toByteArray();
+		QDataStream in(block);
+		in.startTransaction();
+		auto parsed = Packet::AbstractPacket::receivePacket(in, InstanceType::Server, pool);
+		benchmark::DoNotOptimize(in.commitTransaction());
+		bytes += block.size();
+	}
+	state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_ServerPlayerModelRoundTrip)->RangeMultiplier(4)->Range(2, 32);
+
+/**
+ * @brief Measures filling the PlayerModel packet, which the Server does for every change of a player
+ * @param state The benchmark state, range 0 is the number of players
+ */
+static void BM_ServerPlayerModelFill(benchmark::State &state) {
+	Bench::setupCurvers(state.range(0), 0);
+	Packet::ServerPlayerModel packet;
+	for (auto _ : state) {
+		packet.fill();
+		benchmark::DoNotOptimize(packet.data.data());
+	}
+}
+BENCHMARK(BM_ServerPlayerModelFill)->RangeMultiplier(4)->Range(2, 32);
@@ -0,0 +1,83 @@
+#include "loadgenerator.hpp"
+
+#include <QCoreApplication>
+#include <algorithm>
+
+#define REPORT_INTERVAL 1000
+#define RAMP_INTERVAL 1000
+
+/**
+ * @brief Constructs a LoadGenerator
+ * @param options The parameters of the load test
+ * @param parent The parent object
+ */
+LoadGenerator::LoadGenerator(const Options &options, QObject *parent)
+	: QObject(parent), options(options) {
+	connect(&rampTimer, &QTimer::timeout, this, &LoadGenerator::addPlayers);
+	rampTimer.setInterval(RAMP_INTERVAL);
+	connect(&reportTimer, &QTimer::timeout, this, &LoadGenerator::report);
+	reportTimer.setInterval(REPORT_INTERVAL);
+	connect(&durationTimer, &QTimer::timeout, this, [this]() {
+		report();
+		std::vector<double> &rtt = total.roundTripTimes;
+		std::vector<double> &lateness = total.lateness;
+		qInfo().noquote() << QString("total: %1 snapshots, %2 reordered, ping loss %3%, rtt p50 %4 ms p99 %5 ms, lateness p50 %6 ms p99 %7 ms")
+			.arg(total.snapshots).arg(total.reordered).arg(total.pings ? 100.0 * (total.pings - std::min(total.pongs, total.pings)) / total.pings : 0.0, 0, 'f', 1)
+			.arg(percentile(rtt, 0.5)).arg(percentile(rtt, 0.99)).arg(percentile(lateness, 0.5), 0, 'f', 1).arg(percentile(lateness, 0.99), 0, 'f', 1);
+		QCoreApplication::quit();
+	});
+	durationTimer.setSingleShot(true);
+}
+
+/**
+ * @brief Starts the load test
+ */
+void LoadGenerator::start() {
+	qInfo().noquote() << "players\tjoined\tticks/s\tsnapshots/s per player\treordered\tping loss %\trtt p50\trtt p99\tlateness p50\tlateness p99";
+	addPlayers();
+	if (players.size() < static_cast<size_t>(options.players)) {
+		rampTimer.start();
+	} else {
+		durationTimer.start(options.duration * 1000);
+	}
+	reportClock.start();
+	reportTimer.start();
+}
+
+/**
+ * @brief Adds the next step of players
+ */
+void LoadGenerator::addPlayers() {
+	const size_t target = options.ramp > 0 ? std::min<size_t>(players.size() + options.ramp, options.players) : options.players;
+	while (players.size() < target) {
+		const int index = static_cast<int>(players.size());
+		auto &player = players.emplace_back(std::make_unique<SimulatedPlayer>(index, options.server, options.seed + index, options.inputRate));
+		player->connectToServer();
+	}
+	if (players.size() >= static_cast<size_t>(options.players) && rampTimer.isActive()) {
+		rampTimer.stop();
+		durationTimer.start(options.duration * 1000);
+	}
+}
+
+/**
+ * @brief Prints the measurements since the previous report
+ */
+void LoadGenerator::report() {
+	Statistics interval;
+	for (auto &p : players) {
+		interval.merge(p->takeStatistics());
+	}
+	const double seconds = reportClock.restart() / 1000.0;
+	const auto joined = std::ranges::count_if(players, [](const auto &p) { return p->isJoined(); });
+	// the Server falls behind, as soon as it advances less ticks than its update rate
+	const double tickRate = reportedTick && interval.newestTick > reportedTick ? (interval.newestTick - reportedTick) / seconds : 0;
+	reportedTick = std::max(reportedTick, interval.newestTick);
+	const double snapshotRate = joined ? interval.snapshots / seconds / joined : 0;
+	const double pingLoss = interval.pings ? 100.0 * (interval.pings - std::min(interval.pongs, interval.pings)) / interval.pings : 0;
+	qInfo().noquote() << QString("%1\t%2\t%3\t%4\t%5\t%6\t%7\t%8\t%9\t%10")
+		.arg(players.size()).arg(joined).arg(tickRate, 0, 'f', 1).arg(snapshotRate, 0, 'f', 1).arg(interval.reordered).arg(pingLoss, 0, 'f', 1)
+		.arg(percentile(interval.roundTripTimes, 0.5)).arg(percentile(interval.roundTripTimes, 0.99))
+		.arg(percentile(interval.lateness, 0.5), 0, 'f', 1).arg(percentile(interval.lateness, 0.99), 0, 'f', 1);
+	total.merge(interval);
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+#include <memory>
+#include <vector>
+
+#include "simulatedplayer.hpp"
+
+/**
+ * @brief Joins many simulated players to a Server and reports how well the Server keeps up
+ *
+ * Players are added in steps, so that a single run shows at which player count the Server falls behind.
+ * Every report line contains the tick rate of the Server as seen by the players, the received Curver data per player,
+ * how late it arrives compared to the fastest one, and the round trip time and loss of Pings.
+ */
+class LoadGenerator : public QObject {
+	Q_OBJECT
+public:
+	/**
+	 * @brief The parameters of a load test
+	 */
+	struct Options {
+		/**
+		 * @brief The address of the Server
+		 */
+		FullNetworkAddress server;
+		/**
+		 * @brief The number of players to simulate
+		 */
+		int players = 16;
+		/**
+		 * @brief The number of players added every second, or \c 0 to add all at once
+		 */
+		int ramp = 0;
+		/**
+		 * @brief The duration of the test in seconds after the last player was added
+		 */
+		int duration = 30;
+		/**
+		 * @brief The average number of inputs per second of every player
+		 */
+		double inputRate = 4;
+		/**
+		 * @brief The seed of the random inputs
+		 */
+		quint64 seed = 0;
+	};
+
+	explicit LoadGenerator(const Options &options, QObject *parent = nullptr);
+
+	void start();
+private slots:
+	void addPlayers();
+	void report();
+private:
+	/**
+	 * @brief The parameters of the load test
+	 */
+	Options options;
+	/**
+	 * @brief All simulated players
+	 */
+	std::vector<std::unique_ptr<SimulatedPlayer>> players;
+	/**
+	 * @brief The timer that adds the next step of players
+	 */
+	QTimer rampTimer;
+	/**
+	 * @brief The timer of every report line
+	 */
+	QTimer reportTimer;
+	/**
+	 * @brief The timer that ends the load test
+	 */
+	QTimer durationTimer;
+	/**
+	 * @brief The measurements of the whole load test
+	 */
+	Statistics total;
+	/**
+	 * @brief The newest tick of the Server at the previous report, or \c 0 if there was none yet
+	 */
+	quint64 reportedTick = 0;
+	/**
+	 * @brief The time since the previous report
+	 */
+	QElapsedTimer reportClock;
+};
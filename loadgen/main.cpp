@@ -0,0 +1,68 @@
+#include <QCommandLineParser>
+#include <QGuiApplication>
+#include <QHostInfo>
+
+#include "loadgenerator.hpp"
+#include "version.hpp"
+
+/**
+ * @brief Runs a load test against a Server
+ *
+ * Start a headless server first, e.g. with \c -platform \c offscreen, and start the game there once the players joined.
+ * @param argc The number of arguments
+ * @param argv The arguments
+ * @return The exit code
+ */
+int main(int argc, char *argv[]) {
+	// the packets use the models of the game, but nothing is ever rendered
+	qputenv("QT_QPA_PLATFORM", "offscreen");
+	QGuiApplication app(argc, argv);
+	QCoreApplication::setApplicationName("quickcurver_loadgen");
+	QCoreApplication::setApplicationVersion(Version::version_string());
+
+	QCommandLineParser parser;
+	parser.setApplicationDescription("Simulates many network players to load test a Quickcurver server");
+	parser.addHelpOption();
+	parser.addVersionOption();
+	parser.addPositionalArgument("host", "The host of the server");
+	parser.addPositionalArgument("port", "The port of the server");
+	const QCommandLineOption playersOption("players", "The number of simulated players.", "count", "16");
+	const QCommandLineOption rampOption("ramp", "Adds this many players every second instead of all at once.", "count", "0");
+	const QCommandLineOption durationOption("duration", "The duration in seconds after all players were added.", "seconds", "30");
+	const QCommandLineOption inputOption("input-rate", "The average number of inputs per second of every player.", "rate", "4");
+	const QCommandLineOption seedOption("seed", "Seeds the random inputs, so that runs can be reproduced.", "seed", "0");
+	parser.addOptions({playersOption, rampOption, durationOption, inputOption, seedOption});
+	parser.process(app);
+
+	const QStringList arguments = parser.positionalArguments();
+	if (arguments.size() != 2) {
+		parser.showHelp(1);
+	}
+	const QHostInfo info = QHostInfo::fromName(arguments[0]);
+	if (info.error() || info.addresses().isEmpty()) {
+		qCritical() << "Could not resolve" << arguments[0];
+		return 1;
+	}
+	LoadGenerator::Options options;
+	bool ok = false;
+	options.server = {info.addresses().first(), arguments[1].toUShort(&ok)};
+	bool valid = ok;
+	options.players = parser.value(playersOption).toInt(&ok);
+	valid &= ok && options.players > 0;
+	options.ramp = parser.value(rampOption).toInt(&ok);
+	valid &= ok && options.ramp >= 0;
+	options.duration = parser.value(durationOption).toInt(&ok);
+	valid &= ok && options.duration > 0;
+	options.inputRate = parser.value(inputOption).toDouble(&ok);
+	valid &= ok && options.inputRate >= 0;
+	options.seed = parser.value(seedOption).toULongLong(&ok);
+	valid &= ok;
+	if (!valid) {
+		qCritical() << "Invalid arguments";
+		parser.showHelp(1);
+	}
+
+	LoadGenerator generator(options);
+	generator.start();
+	return app.exec();
+}
@@ -0,0 +1,235 @@
+#include "simulatedplayer.hpp"
+
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#define PING_INTERVAL 1000
+// must cover at least the history of the Server
+#define FRAME_HISTORY_SIZE 64
+// the number of the latest inputs repeated in every ClientCurverRotation, the same as a Client
+#define INPUT_REDUNDANCY 4
+
+/**
+ * @brief Constructs a SimulatedPlayer
+ * @param index The index of the player, which is part of its name
+ * @param server The address of the Server
+ * @param seed The seed of the random inputs
+ * @param inputRate The average number of inputs per second
+ * @param parent The parent object
+ */
+SimulatedPlayer::SimulatedPlayer(const int index, const FullNetworkAddress server, const std::mt19937::result_type seed, const double inputRate, QObject *parent)
+	: QObject(parent), index(index), server(server), inputRate(inputRate), rng(seed), arrivalOffset(std::numeric_limits<double>::quiet_NaN()) {
+	connect(&tcpSocket, &QTcpSocket::connected, this, &SimulatedPlayer::socketConnected);
+	connect(&tcpSocket, &QTcpSocket::disconnected, this, &SimulatedPlayer::socketDisconnected);
+	connect(&tcpSocket, &QTcpSocket::readyRead, this, &SimulatedPlayer::socketReadyRead);
+	connect(&udpSocket, &QUdpSocket::readyRead, this, &SimulatedPlayer::udpSocketReadyRead);
+	connect(&inputTimer, &QTimer::timeout, this, &SimulatedPlayer::sendInput);
+	inputTimer.setSingleShot(true);
+	connect(&pingTimer, &QTimer::timeout, this, &SimulatedPlayer::sendPing);
+	pingTimer.setInterval(PING_INTERVAL);
+	clock.start();
+	// choose an arbitrary local port for UDP
+	udpSocket.bind();
+}
+
+/**
+ * @brief Starts joining the Server
+ */
+void SimulatedPlayer::connectToServer() {
+	tcpSocket.connectToHost(server.addr, server.port);
+}
+
+/**
+ * @brief Returns whether the player completed joining the Server
+ * @return \c True, iif the Server answered a Ping
+ */
+bool SimulatedPlayer::isJoined() const {
+	return joined;
+}
+
+/**
+ * @brief Returns the measurements since the last call and starts new ones
+ * @return The measurements
+ */
+Statistics SimulatedPlayer::takeStatistics() {
+	return std::exchange(statistics, {});
+}
+
+/**
+ * @brief Called, when the TCP connection is established
+ */
+void SimulatedPlayer::socketConnected() {
+	Packet::ClientPlayerModel p;
+	p.username = QString("loadgen %1").arg(index);
+	p.color = QColor::fromHsv((index * 47) % 360, 255, 255);
+	p.sendPacket(&tcpSocket);
+}
+
+/**
+ * @brief Called, when the Server closed the connection
+ */
+void SimulatedPlayer::socketDisconnected() {
+	qWarning() << "Player" << index << "was disconnected";
+	joined = false;
+	inputTimer.stop();
+	pingTimer.stop();
+}
+
+/**
+ * @brief Called, when there is new data available on the TCP socket
+ */
+void SimulatedPlayer::socketReadyRead() {
+	tcpFrames.append(tcpSocket);
+	QByteArray frame;
+	while (tcpFrames.next(frame)) {
+		QDataStream in(frame);
+		auto packet = Packet::AbstractPacket::receivePacket(in, InstanceType::Server, packets);
+		if (in.status() == QDataStream::Ok) {
+			handlePacket(packet);
+		}
+	}
+	if (tcpFrames.isCorrupt()) {
+		qWarning() << "Player" << index << "received an invalid frame";
+		tcpSocket.abort();
+	}
+}
+
+/**
+ * @brief Handles incoming UDP datagrams
+ */
+void SimulatedPlayer::udpSocketReadyRead() {
+	while (udpSocket.hasPendingDatagrams()) {
+		QByteArray datagram;
+		datagram.resize(udpSocket.pendingDatagramSize());
+		udpSocket.readDatagram(datagram.data(), datagram.size());
+		QDataStream udpStream(&datagram, QIODevice::ReadOnly);
+		auto packet = Packet::AbstractPacket::receivePacket(udpStream, InstanceType::Server, packets);
+		if (udpStream.status() == QDataStream::Ok) {
+			handlePacket(packet);
+		}
+	}
+}
+
+/**
+ * @brief Sends a random input and schedules the next one
+ */
+void SimulatedPlayer::sendInput() {
+	inputs.push_back(static_cast<Curver::Rotation>(std::uniform_int_distribution(0, 2)(rng)));
+	if (inputs.size() > INPUT_REDUNDANCY) {
+		inputs.pop_front();
+	}
+	Packet::ClientCurverRotation p;
+	p.rotations.assign(inputs.begin(), inputs.end());
+	p.sequence = ++inputSequence;
+	p.sendPacketUdp(&udpSocket, server);
+	scheduleInput();
+}
+
+/**
+ * @brief Sends a Ping to the Server
+ */
+void SimulatedPlayer::sendPing() {
+	Packet::Ping p;
+	p.delta = ping;
+	p.playerId = playerId;
+	p.sendPacketUdp(&udpSocket, server);
+	++statistics.pings;
+}
+
+/**
+ * @brief Leaves a Lobby and joins the room that it redirected the player to
+ * @param port The port of the room on the same host as the Lobby
+ */
+void SimulatedPlayer::redirect(const quint16 port) {
+	{
+		const QSignalBlocker blocker(tcpSocket);
+		tcpSocket.abort();
+	}
+	tcpFrames.clear();
+	server.port = port;
+	connectToServer();
+}
+
+/**
+ * @brief Processes a received packet
+ * @param p The packet that was received
+ */
+void SimulatedPlayer::handlePacket(Packet::AbstractPacket *p) {
+	switch (static_cast<Packet::ServerTypes>(p->type)) {
+	case Packet::ServerTypes::CurverData:
+		handleCurverData((Packet::ServerCurverData *) p);
+		break;
+	case Packet::ServerTypes::SettingsType:
+		updatesPerSecond = std::max(((Packet::ServerSettingsData *) p)->updatesPerSecond, 1u);
+		break;
+	case Packet::ServerTypes::Welcome:
+		playerId = ((Packet::ServerWelcome *) p)->playerId;
+		sendPing();
+		pingTimer.start();
+		break;
+	case Packet::ServerTypes::Redirect:
+		{
+			const quint16 port = ((Packet::ServerRedirect *) p)->port;
+			QMetaObject::invokeMethod(this, [this, port]() { redirect(port); }, Qt::QueuedConnection);
+			break;
+		}
+	case Packet::ServerTypes::Pong:
+		{
+			ping = Util::getTimeDiff(((Packet::Pong *) p)->sent);
+			++statistics.pongs;
+			statistics.roundTripTimes.push_back(ping);
+			if (!joined) {
+				joined = true;
+				scheduleInput();
+			}
+			break;
+		}
+	default:
+		// chat, players and items do not matter for the load
+		break;
+	}
+}
+
+/**
+ * @brief Records received Curver data and acknowledges it like a Client does
+ * @param curverData The received packet
+ */
+void SimulatedPlayer::handleCurverData(Packet::ServerCurverData *curverData) {
+	const double tickTime = curverData->tick * 1000.0 / updatesPerSecond;
+	const double offset = clock.nsecsElapsed() / 1e6 - tickTime;
+	if (std::isnan(arrivalOffset) || offset < arrivalOffset) {
+		arrivalOffset = offset;
+	}
+	++statistics.snapshots;
+	statistics.lateness.push_back(offset - arrivalOffset);
+	statistics.newestTick = std::max(statistics.newestTick, curverData->tick);
+	if (curverData->tick < newestTick) {
+		++statistics.reordered;
+		return;
+	}
+	newestTick = curverData->tick;
+	if (!curverData->resolve(frameHistory)) {
+		return;
+	}
+	if (frameHistory.empty() || frameHistory.back().tick < curverData->tick) {
+		frameHistory.push_back(curverData->frame());
+		if (frameHistory.size() > FRAME_HISTORY_SIZE) {
+			frameHistory.pop_front();
+		}
+		Packet::SnapshotAck ack;
+		ack.tick = curverData->tick;
+		ack.sendPacketUdp(&udpSocket, server);
+	}
+}
+
+/**
+ * @brief Schedules the next input after an exponentially distributed delay
+ */
+void SimulatedPlayer::scheduleInput() {
+	if (inputRate <= 0) {
+		return;
+	}
+	const double delay = std::exponential_distribution(inputRate)(rng);
+	inputTimer.start(static_cast<int>(delay * 1000));
+}
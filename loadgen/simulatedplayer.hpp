@@ -0,0 +1,127 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+#include <deque>
+#include <random>
+
+#include "network/framebuffer.hpp"
+#include "network/network.hpp"
+#include "statistics.hpp"
+
+/**
+ * @brief A player that joins a Server over the network without any game or GUI
+ *
+ * It speaks the same protocol as a Client: It joins via TCP, binds its UDP address with a Ping,
+ * sends random Curver rotations and acknowledges the Curver data that it receives.
+ * Meanwhile it records, when the Curver data arrives and how long Pings take.
+ */
+class SimulatedPlayer : public QObject {
+	Q_OBJECT
+public:
+	explicit SimulatedPlayer(const int index, const FullNetworkAddress server, const std::mt19937::result_type seed, const double inputRate, QObject *parent = nullptr);
+
+	void connectToServer();
+	bool isJoined() const;
+	Statistics takeStatistics();
+private slots:
+	void socketConnected();
+	void socketDisconnected();
+	void socketReadyRead();
+	void udpSocketReadyRead();
+	void sendInput();
+	void sendPing();
+	void redirect(const quint16 port);
+private:
+	void handlePacket(Packet::AbstractPacket *p);
+	void handleCurverData(Packet::ServerCurverData *curverData);
+	void scheduleInput();
+
+	/**
+	 * @brief The index of the player, which is part of its name
+	 */
+	int index;
+	/**
+	 * @brief The address of the Server
+	 */
+	FullNetworkAddress server;
+	/**
+	 * @brief The TCP connection to the Server
+	 */
+	QTcpSocket tcpSocket;
+	/**
+	 * @brief The UDP socket to communicate with
+	 */
+	QUdpSocket udpSocket;
+	/**
+	 * @brief The bytes received on SimulatedPlayer::tcpSocket, that are split into packets
+	 */
+	FrameBuffer tcpFrames;
+	/**
+	 * @brief The instances that received packets are parsed into
+	 */
+	Packet::PacketPool packets;
+	/**
+	 * @brief The player id that the Server assigned, or \c 0 if there is none yet
+	 */
+	quint32 playerId = 0;
+	/**
+	 * @brief Whether the Server answered a Ping, which completes the join
+	 */
+	bool joined = false;
+	/**
+	 * @brief The number of simulation ticks per second of the Server
+	 */
+	quint32 updatesPerSecond = 60;
+	/**
+	 * @brief The most recently received frames, which the Server encodes Curver data against
+	 */
+	std::deque<Packet::CurverFrame> frameHistory;
+	/**
+	 * @brief The tick of the newest received Curver data
+	 */
+	quint64 newestTick = 0;
+	/**
+	 * @brief The sequence number of the newest input
+	 */
+	quint32 inputSequence = 0;
+	/**
+	 * @brief The newest inputs, which are repeated in every ClientCurverRotation like a Client does
+	 */
+	std::deque<Curver::Rotation> inputs;
+	/**
+	 * @brief The average number of inputs per second
+	 */
+	double inputRate;
+	/**
+	 * @brief The random generator of the inputs
+	 */
+	std::mt19937 rng;
+	/**
+	 * @brief The timer of the next input
+	 */
+	QTimer inputTimer;
+	/**
+	 * @brief The timer responsible for continuously sending a Ping to the Server
+	 */
+	QTimer pingTimer;
+	/**
+	 * @brief The latest measured round trip time in milliseconds
+	 */
+	qint64 ping = 0;
+	/**
+	 * @brief The smallest difference between the local arrival time and the tick time of any Curver data, or \c NaN if there was none yet
+	 *
+	 * The fastest Curver data defines a lateness of zero.
+	 */
+	double arrivalOffset;
+	/**
+	 * @brief The local clock that arrival times refer to
+	 */
+	QElapsedTimer clock;
+	/**
+	 * @brief The measurements since the last call of takeStatistics()
+	 */
+	Statistics statistics;
+};
@@ -0,0 +1,33 @@
+#include "statistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Adds the measurements of another player
+ * @param other The measurements to add
+ */
+void Statistics::merge(const Statistics &other) {
+	snapshots += other.snapshots;
+	reordered += other.reordered;
+	pings += other.pings;
+	pongs += other.pongs;
+	roundTripTimes.insert(roundTripTimes.end(), other.roundTripTimes.begin(), other.roundTripTimes.end());
+	lateness.insert(lateness.end(), other.lateness.begin(), other.lateness.end());
+	newestTick = std::max(newestTick, other.newestTick);
+}
+
+/**
+ * @brief Returns a percentile of some values
+ * @param values The values, which are partially reordered
+ * @param p The percentile between \c 0 and \c 1
+ * @return The value at the percentile, or \c 0 if there are no values
+ */
+double percentile(std::vector<double> &values, const double p) {
+	if (values.empty()) {
+		return 0;
+	}
+	const auto nth = values.begin() + std::clamp<ptrdiff_t>(std::lround(p * (values.size() - 1)), 0, values.size() - 1);
+	std::ranges::nth_element(values, nth);
+	return *nth;
+}
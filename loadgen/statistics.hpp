@@ -0,0 +1,41 @@
+#pragma once
+
+#include <QtGlobal>
+#include <vector>
+
+/**
+ * @brief The measurements of simulated players during one report interval
+ */
+struct Statistics {
+	void merge(const Statistics &other);
+	/**
+	 * @brief The number of received Curver data packets
+	 */
+	size_t snapshots = 0;
+	/**
+	 * @brief The number of received Curver data packets, that were older than one received before
+	 */
+	size_t reordered = 0;
+	/**
+	 * @brief The number of sent Ping packets
+	 */
+	size_t pings = 0;
+	/**
+	 * @brief The number of received Pong packets
+	 */
+	size_t pongs = 0;
+	/**
+	 * @brief The round trip time in milliseconds of every received Pong
+	 */
+	std::vector<double> roundTripTimes;
+	/**
+	 * @brief How many milliseconds every Curver data arrived later than the fastest one of the same player
+	 */
+	std::vector<double> lateness;
+	/**
+	 * @brief The newest tick of the Server that was received
+	 */
+	quint64 newestTick = 0;
+};
+
+double percentile(std::vector<double> &values, const double p);
@@ -94,6 +94,17 @@ void CommandlineReader::run() {
 					if (takeInt(width, parts, "width") && takeInt(height, parts, "height")) {
 						resize(QPoint(width, height));
 					}
+				} else if (command == "seed") {
+					QString text;
+					bool ok = false;
+					if (takeString(text, parts, "Seed")) {
+						const quint64 value = text.toULongLong(&ok);
+						if (ok) {
+							seed(value);
+						} else {
+							qInfo() << "The seed must be a non-negative integer";
+						}
+					}
 				} else if (command == "start") {
 					start();
 				} else if (command == "score") {
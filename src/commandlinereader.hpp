@@ -76,6 +76,11 @@ signals:
 	 * @param dimension The new dimension
 	 */
 	void resize(QPoint dimension);
+	/**
+	 * @brief The user wants to seed the random generator
+	 * @param seed The new seed
+	 */
+	void seed(quint64 seed);
 	/**
 	 * @brief The user wants to start the game
 	 */
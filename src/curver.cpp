@@ -6,18 +6,23 @@
 #define SEGMENT_USE_TIME_MIN 5000
 #define SEGMENT_USE_TIME_MAX 8000
 #define SEGMENT_CHANGE_TIME 300
+// the maximum number of inputs of a remote player waiting to be applied, older ones are dropped
+#define MAX_QUEUED_INPUTS 64
 
 /**
  * @brief Constructs a Curver object that belongs to \a parentNode in the scene graph
- * @param parentNode The parent node in the scene graph
+ * @param parentNode The parent node in the scene graph, or \c nullptr to not render the Curver at all
+ * @param random The random generator of the game
  */
-Curver::Curver(QSGNode *parentNode) {
+Curver::Curver(QSGNode *parentNode, Random *random) {
 	this->parentNode = parentNode;
+	this->random = random;
 
-	nextSegmentEvent = QTime::currentTime();
-	setColor(Util::randColor());
+	setColor(random->randColor());
 	// random initial rotation
-	headNode = std::make_unique<HeadNode>(parentNode, &material);
+	if (parentNode) {
+		headNode = std::make_unique<HeadNode>(parentNode, &material);
+	}
 	resetRound();
 
 	connect(&cleaninstallAnimation, &CleaninstallAnimation::spawnExplosion, std::bind(&Curver::spawnExplosion, this, std::placeholders::_1, 0.3));
@@ -111,6 +116,14 @@ float Curver::getAngle() const {
 	return angle;
 }
 
+/**
+ * @brief Returns everything that determines the path of the Curver
+ * @return The current motion
+ */
+Curver::Motion Curver::getMotion() const {
+	return {lastPos, angle, velocity, rotateVelocity, rotation};
+}
+
 /**
  * @brief Determines if the Curver is currently changing segments
  * @return \c True, iif changing segments at the moment
@@ -151,18 +164,25 @@ void Curver::start() {
  * @param deltat The amount of time since the last update in milliseconds
  * @param curvers All curvers
  */
-void Curver::progress(int deltat, std::vector<std::unique_ptr<Curver>> &curvers) {
-	// update all explosions
-	std::ranges::for_each(explosions, [](auto &i) { i->progress(); });
-	cleaninstallAnimation.progress();
+void Curver::progress(const float deltat, std::vector<std::unique_ptr<Curver>> &curvers) {
+	animate();
+	if (deltat > 0 && !queuedInputs.empty()) {
+		// remote inputs take effect one per tick, like the Client predicted them
+		inputSequence = queuedInputs.front().first;
+		rotation = queuedInputs.front().second;
+		queuedInputs.pop_front();
+	}
 	if (!isAlive()) {
 		return;
 	}
 
-	if (nextSegmentEvent <= QTime::currentTime()) {
+	if (deltat > 0) {
+		++tick;
+	}
+	if (nextSegmentEvent <= tick) {
 		if (changingSegment) {
 			// spawn a new segment
-			segments.push_back(std::make_unique<Segment>(parentNode, &material, thickness));
+			segments.push_back(std::make_unique<Segment>(parentNode, &material, thickness, &grid));
 			prepareSegmentEvent(false, SEGMENT_USE_TIME_MIN, SEGMENT_USE_TIME_MAX);
 		} else {
 			// plan a new segment spawn
@@ -170,14 +190,15 @@ void Curver::progress(int deltat, std::vector<std::unique_ptr<Curver>> &curvers)
 		}
 	}
 	secondLastPos = lastPos;
-	if (rotation == Rotation::ROTATE_LEFT) {
-		rotate(-deltat * rotateVelocity);
-	} else if (rotation == Rotation::ROTATE_RIGHT) {
-		rotate(deltat * rotateVelocity);
-	}
-	lastPos += deltat * static_cast<double>(velocity) * direction;
+	Motion motion = getMotion();
+	motion.step(deltat);
+	lastPos = motion.pos;
+	angle = motion.angle;
+	direction = QPointF(cos(angle), sin(angle));
 	if (headVisible) {
-		headNode->setPosition(lastPos);
+		if (headNode) {
+			headNode->setPosition(lastPos);
+		}
 	} else {
 		// it is not possible to have both head invisible and not changing segment
 		// check for collision
@@ -196,6 +217,17 @@ void Curver::progress(int deltat, std::vector<std::unique_ptr<Curver>> &curvers)
 	checkForWall();
 }
 
+/**
+ * @brief Progresses the animations of the Curver, but not the Curver itself
+ *
+ * This is enough for a Client, where the positions come from the Server, see Client::interpolate().
+ */
+void Curver::animate() {
+	// update all explosions
+	std::ranges::for_each(explosions, [](auto &i) { i->progress(); });
+	cleaninstallAnimation.progress();
+}
+
 /**
  * @brief Checks, if any Curver collides with the line from \a a to \a b
  * @param curvers All Curvers
@@ -204,13 +236,8 @@ void Curver::progress(int deltat, std::vector<std::unique_ptr<Curver>> &curvers)
  * @return \c True, iif the line collides
  */
 bool Curver::checkForIntersection(std::vector<std::unique_ptr<Curver>> &curvers, QPointF a, QPointF b) const {
-	for (auto &i : curvers) {
-		const auto &otherSegments = i->getSegments();
-		if (otherSegments.end() != std::ranges::find_if(otherSegments, [&](auto &segment) { return segment->checkForIntersection(a, b); })) {
-			return true;
-		}
-	}
-	return false;
+	// only the edges near the line are checked, see SpatialGrid
+	return std::ranges::any_of(curvers, [&](auto &c) { return c->grid.checkForIntersection(a, b); });
 }
 
 /**
@@ -232,6 +259,8 @@ void Curver::checkForWall() {
  */
 void Curver::cleanInstall() {
 	prepareSegmentEvent(true, CLEAN_INVINCIBLE_DURATION, CLEAN_INVINCIBLE_DURATION);
+	// the old segments must not collide anymore while they fade out
+	std::ranges::for_each(segments, [](auto &s) { s->setGrid(nullptr); });
 	// spawn cleaninstall animation and remove segments with it
 	cleaninstallAnimation.trigger(segments);
 }
@@ -244,16 +273,41 @@ void Curver::increaseScore() {
 	++totalScore;
 }
 
+/**
+ * @brief Queues the inputs of a remote player, so that every tick applies the next one
+ *
+ * Every datagram repeats the latest inputs, so the inputs missed because of a lost datagram are recovered from a later one.
+ * Inputs that were already queued or applied are skipped.
+ * @param sequence The sequence number of the newest input
+ * @param rotations The latest inputs, ordered from the oldest to the newest one
+ */
+void Curver::queueInputs(const quint32 sequence, const std::vector<Rotation> &rotations) {
+	const quint32 newest = queuedInputs.empty() ? inputSequence : queuedInputs.back().first;
+	if (sequence <= newest) {
+		return;
+	}
+	const size_t count = std::min<size_t>(sequence - newest, rotations.size());
+	for (size_t i = rotations.size() - count; i < rotations.size(); ++i) {
+		queuedInputs.emplace_back(sequence - (rotations.size() - 1 - i), rotations[i]);
+	}
+	while (queuedInputs.size() > MAX_QUEUED_INPUTS) {
+		queuedInputs.pop_front();
+	}
+}
+
 /**
  * @brief Resets the round
  */
 void Curver::resetRound() {
 	explosions.clear();
 	segments.clear();
+	predictedSegment.reset();
 	// random start position
 	QPoint dimension = Settings::get()->getDimension();
-	lastPos = QPointF(Util::randInt(SPAWN_WALL_THRESHOLD, dimension.x() - SPAWN_WALL_THRESHOLD), Util::randInt(SPAWN_WALL_THRESHOLD, dimension.y() - SPAWN_WALL_THRESHOLD));
-	rotate(Util::rand() * 2 * M_PI);
+	grid.reset(dimension);
+	const int x = random->randInt(SPAWN_WALL_THRESHOLD, dimension.x() - SPAWN_WALL_THRESHOLD);
+	lastPos = QPointF(x, random->randInt(SPAWN_WALL_THRESHOLD, dimension.y() - SPAWN_WALL_THRESHOLD));
+	rotate(random->rand() * 2 * M_PI);
 	prepareSegmentEvent(true, SPAWN_INVINCIBLE_DURATION, SPAWN_INVINCIBLE_DURATION);
 	roundScore = 0;
 	alive = true;
@@ -288,9 +342,9 @@ bool Curver::isAlive() const {
 void Curver::appendPoint(const QPointF pos, const bool changingSegment) {
 	// segments.size() test fixes a bug, where a client would crash due to network lag
 	if (!changingSegment && (oldChangingSegment || segments.size() == 0)) {
-		segments.push_back(std::make_unique<Segment>(parentNode, &material, thickness));
+		segments.push_back(std::make_unique<Segment>(parentNode, &material, thickness, &grid));
 	}
-	if (headVisible) {
+	if (headVisible && headNode) {
 		headNode->setPosition(pos);
 	}
 	if (!changingSegment && pos != lastPos) {
@@ -307,6 +361,37 @@ void Curver::appendPoint(const QPointF pos, const bool changingSegment) {
 	lastPos = pos;
 }
 
+/**
+ * @brief Shows the predicted path ahead of the confirmed segments
+ *
+ * This replaces the previously predicted path and moves the head to its end.
+ * Nothing but the head is shown, while the last confirmed position was changing segments.
+ * @param path The predicted positions starting at the last position passed to appendPoint(), or empty to hide the prediction
+ */
+void Curver::setPredictedPath(const std::vector<QPointF> &path) {
+	if (!parentNode) {
+		return;
+	}
+	if (!predictedSegment) {
+		predictedSegment = std::make_unique<Segment>(parentNode, &material, thickness, nullptr);
+	}
+	predictedSegment->clear();
+	if (path.empty()) {
+		return;
+	}
+	if (headVisible && headNode) {
+		headNode->setPosition(path.back());
+	}
+	if (oldChangingSegment) {
+		return;
+	}
+	for (size_t i = 0; i < path.size(); ++i) {
+		// the first point continues the direction of the second one
+		const QPointF diff = i ? path[i] - path[i - 1] : (path.size() > 1 ? path[1] - path[0] : direction);
+		predictedSegment->appendPoint(path[i], atan2(diff.y(), diff.x()));
+	}
+}
+
 /**
  * @brief Prepares a segment event.
  *
@@ -316,7 +401,7 @@ void Curver::appendPoint(const QPointF pos, const bool changingSegment) {
  * @param upper The upper random boundary of the segment event
  */
 void Curver::prepareSegmentEvent(bool changingSegment, int lower, int upper) {
-	nextSegmentEvent = QTime::currentTime().addMSecs(Util::randInt(lower, upper));
+	nextSegmentEvent = tick + Settings::get()->msecsToTicks(random->randInt(lower, upper));
 	this->changingSegment = changingSegment;
 }
 
@@ -326,7 +411,11 @@ void Curver::prepareSegmentEvent(bool changingSegment, int lower, int upper) {
  * @param radius The size of the explosion
  */
 void Curver::spawnExplosion(QPointF location, float radius) {
-	explosions.emplace_back(std::make_unique<Explosion>(location, parentNode, &material, this, radius));
+	// explosions are purely visual
+	if (!parentNode) {
+		return;
+	}
+	explosions.emplace_back(std::make_unique<Explosion>(location, parentNode, &material, *random, this, radius));
 }
 
 /**
@@ -334,14 +423,36 @@ void Curver::spawnExplosion(QPointF location, float radius) {
  * @param radians The amount of radian to rotate
  */
 void Curver::rotate(float radians) {
-	angle += radians;
+	angle = wrapAngle(angle + radians);
+	direction.setX(cos(angle));
+	direction.setY(sin(angle));
+}
+
+/**
+ * @brief Wraps an angle, that is at most one turn off, into the range from 0 to 2 pi
+ * @param angle The angle in radian
+ * @return The wrapped angle
+ */
+float Curver::wrapAngle(const float angle) {
 	if (angle < 0) {
-		angle += 2 * M_PI;
+		return angle + 2 * M_PI;
 	} else if (angle > 2 * M_PI) {
-		angle -= 2 * M_PI;
+		return angle - 2 * M_PI;
 	}
-	direction.setX(cos(angle));
-	direction.setY(sin(angle));
+	return angle;
+}
+
+/**
+ * @brief Moves by the given amount of time
+ * @param deltat The amount of time in milliseconds
+ */
+void Curver::Motion::step(const float deltat) {
+	if (rotation == Rotation::ROTATE_LEFT) {
+		angle = wrapAngle(angle - deltat * rotateVelocity);
+	} else if (rotation == Rotation::ROTATE_RIGHT) {
+		angle = wrapAngle(angle + deltat * rotateVelocity);
+	}
+	pos += deltat * static_cast<double>(velocity) * QPointF(cos(angle), sin(angle));
 }
 
 /**
@@ -4,12 +4,15 @@
 #include <QSGFlatColorMaterial>
 #include <QSGNode>
 #include <QTime>
+#include <deque>
 
 #include "cleaninstallanimation.hpp"
 #include "explosion.hpp"
 #include "headnode.hpp"
+#include "random.hpp"
 #include "segment.hpp"
 #include "settings.hpp"
+#include "spatialgrid.hpp"
 
 /**
  * @brief The Curver class represents a player and all the segments belonging to the player
@@ -35,8 +38,37 @@ public:
 		CONTROLLER_REMOTE,
 		CONTROLLER_BOT
 	};
+	/**
+	 * @brief Everything that determines the path of a Curver
+	 *
+	 * This is shared by the game logic and the prediction of a Client, so both move a Curver in exactly the same way.
+	 */
+	struct Motion {
+		void step(const float deltat);
+
+		/**
+		 * @brief The position
+		 */
+		QPointF pos;
+		/**
+		 * @brief The angle of the direction in radian
+		 */
+		float angle = 0;
+		/**
+		 * @brief The velocity in pixels per millisecond
+		 */
+		float velocity = 0;
+		/**
+		 * @brief The rotational velocity in radian per millisecond
+		 */
+		float rotateVelocity = 0;
+		/**
+		 * @brief The rotation
+		 */
+		Rotation rotation = Rotation::ROTATE_NONE;
+	};
 
-	explicit Curver(QSGNode *parentNode);
+	explicit Curver(QSGNode *parentNode, Random *random);
 	~Curver();
 
 	void setColor(const QColor color);
@@ -49,11 +81,13 @@ public:
 	QPointF getPos() const;
 	QPointF getDirection() const;
 	float getAngle() const;
+	Motion getMotion() const;
 	bool isChangingSegment() const;
 
 	void processKey(Qt::Key key, bool release = false);
 	void start();
-	void progress(int deltat, std::vector<std::unique_ptr<Curver>> &curvers);
+	void progress(const float deltat, std::vector<std::unique_ptr<Curver>> &curvers);
+	void animate();
 	bool checkForIntersection(std::vector<std::unique_ptr<Curver>> &curvers, QPointF a, QPointF b) const;
 	void checkForWall();
 	void cleanInstall();
@@ -64,6 +98,8 @@ public:
 	void appendPoint(const QPointF pos, const bool changingSegment);
 	void prepareSegmentEvent(bool changingSegment, int lower, int upper);
 	void spawnExplosion(QPointF location, float radius = 1.0);
+	void setPredictedPath(const std::vector<QPointF> &path);
+	void queueInputs(const quint32 sequence, const std::vector<Rotation> &rotations);
 
 	/**
 	 * @brief The username of the Curver
@@ -81,6 +117,10 @@ public:
 	 * @brief The current rotation
 	 */
 	Rotation rotation = Rotation::ROTATE_NONE;
+	/**
+	 * @brief The sequence number of the last input of a remote player, that was applied to Curver::rotation
+	 */
+	quint32 inputSequence = 0;
 	/**
 	 * @brief The current controller of this Curver
 	 */
@@ -111,11 +151,16 @@ private slots:
 private:
 	void rotate(float radians);
 	void die();
+	static float wrapAngle(const float angle);
 
 	/**
-	 * @brief The parent node in the scene graph
+	 * @brief The parent node in the scene graph, or \c nullptr if the Curver is not rendered
 	 */
 	QSGNode *parentNode;
+	/**
+	 * @brief The random generator of the game
+	 */
+	Random *random;
 	/**
 	 * @brief The color of this Curver
 	 */
@@ -124,14 +169,30 @@ private:
 	 * @brief The material in use with the color determined by Curver::color
 	 */
 	QSGFlatColorMaterial material;
+	/**
+	 * @brief The grid indexing all edges of Curver::segments for collision queries
+	 *
+	 * Must be declared before Curver::segments, because every Segment unregisters itself on destruction.
+	 */
+	SpatialGrid grid;
 	/**
 	 * @brief A vector containing all segments of this Curver
 	 */
 	std::vector<std::unique_ptr<Segment>> segments;
 	/**
-	 * @brief The node representing the head of this Curver
+	 * @brief The inputs of a remote player with their sequence numbers, that were received but not applied yet, see queueInputs()
+	 */
+	std::deque<std::pair<quint32, Rotation>> queuedInputs;
+	/**
+	 * @brief The node representing the head of this Curver, or \c nullptr if the Curver is not rendered
 	 */
 	std::unique_ptr<HeadNode> headNode;
+	/**
+	 * @brief The segment showing the predicted path ahead of the confirmed segments, see setPredictedPath()
+	 *
+	 * It is not part of Curver::segments and never collides.
+	 */
+	std::unique_ptr<Segment> predictedSegment;
 	/**
 	 * @brief The current line thickness
 	 */
@@ -165,11 +226,16 @@ private:
 	 */
 	bool changingSegment = false;
 	/**
-	 * @brief The time of the next planned segment event
+	 * @brief The number of simulation ticks that the Curver went through
+	 */
+	quint64 tick = 0;
+	/**
+	 * @brief The tick of the next planned segment event, see Curver::tick
 	 *
 	 * A segment event can be the spawn of a new segment or leaving the current segment.
+	 * It is planned in ticks instead of wall-clock time, so that a game with the same seed always draws the same random numbers.
 	 */
-	QTime nextSegmentEvent;
+	quint64 nextSegmentEvent = 0;
 	/**
 	 * @brief Decides whether the Curver is alive at the moment
 	 */
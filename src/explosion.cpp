@@ -5,10 +5,11 @@
  * @param location The location to spawn at
  * @param parentNode The parent node in the scene graph
  * @param material The material to use for drawing calls
+ * @param random The random generator to scatter the particles with
  * @param parent The parent object
  * @param radius The size of the explosion
  */
-Explosion::Explosion(QPointF location, QSGNode *parentNode, QSGFlatColorMaterial *material, QObject *parent, float radius) {
+Explosion::Explosion(QPointF location, QSGNode *parentNode, QSGFlatColorMaterial *material, Random &random, QObject *parent, float radius) {
 	this->location = location;
 	this->parentNode = parentNode;
 
@@ -29,7 +30,7 @@ Explosion::Explosion(QPointF location, QSGNode *parentNode, QSGFlatColorMaterial
 	for (int i = 0; i < PARTICLECOUNT; ++i) {
 		vertices[2 * i].set(location.x(), location.y());
 		vertices[2 * i + 1].set(location.x(), location.y());
-		particleDirections[i] = radius * (Util::randQPointF() - QPointF(0.5, 0.5));
+		particleDirections[i] = radius * (random.randQPointF() - QPointF(0.5, 0.5));
 	}
 	opacityNode->appendChildNode(geoNode.get());
 	parentNode->appendChildNode(opacityNode.get());
@@ -5,6 +5,7 @@
 #include <QtQuick>
 #include <memory>
 
+#include "random.hpp"
 #include "util.hpp"
 
 #define PARTICLECOUNT 64
@@ -20,7 +21,7 @@
 class Explosion : public QObject {
 	Q_OBJECT
 public:
-	explicit Explosion(QPointF location, QSGNode *parentNode, QSGFlatColorMaterial *material, QObject *parent = nullptr, float radius = 1.0);
+	explicit Explosion(QPointF location, QSGNode *parentNode, QSGFlatColorMaterial *material, Random &random, QObject *parent = nullptr, float radius = 1.0);
 	~Explosion();
 	void progress();
 private:
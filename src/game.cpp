@@ -7,19 +7,21 @@
  * @param parent The parent to draw on
  */
 Game::Game(QQuickItem *parent)
-	: QQuickItem(parent) {
+	: QQuickItem(parent), simulation([this](const float deltat) { tick(deltat); }) {
 	/* Create a new root node. No, this does not leak memory, the Qt scene graph automatically deletes this node at the end.
 	 * The scene graph knows this root node from updatePaintNode and will destroy it, when the window closes.
 	 * Do NOT under any circumstances delete this node, or otherwise Qt will try to double free it,
 	 * which will result in a big Qt backtrace when the window closes.
 	 * Trust me, you do not want to debug this again.
+	 * A headless server never renders anything, so it keeps its game state free of scene graph nodes altogether.
 	*/
-	rootNode = new QSGNode();
-	itemFactory = std::make_unique<ItemFactory>(rootNode);
+	rootNode = Settings::get()->getOffscreen() ? nullptr : new QSGNode();
+	itemFactory = std::make_unique<ItemFactory>(rootNode, &random);
 	// notify the item factory about window changes
 	connect(this, &QQuickItem::windowChanged, itemFactory.get(), &ItemFactory::setWindow);
 	// tell the playermodel, what the root node is, so that it can tell its curvers
 	PlayerModel::get()->setRootNode(this->rootNode);
+	PlayerModel::get()->setRandom(&random);
 	connect(PlayerModel::get(), &PlayerModel::curverDied, this, &Game::curverDied);
 	connect(PlayerModel::get(), &PlayerModel::playerModelChanged, &server, &Server::broadcastPlayerModel);
 	connect(ItemModel::get(), &ItemModel::itemSpawned, &server, &Server::broadcastItemData);
@@ -31,14 +33,19 @@ Game::Game(QQuickItem *parent)
 	connect(&Gui::getSingleton(), &Gui::postInfoBar, this, &Game::postInfoBar);
 	connect(&Gui::getSingleton(), &Gui::startGame, this, &Game::tryStartGame);
 
+	gameTimer.setTimerType(Qt::PreciseTimer);
 	connect(&gameTimer, &QTimer::timeout, this, &Game::progress);
 	// tell QtQuick, that this component wants to draw stuff
 	setFlag(ItemHasContents);
 }
 
 Game::~Game() {
+	// the simulation thread must not outlive anything it touches
+	simulation.stop();
 	// we do manual memory management with every child node, so we have to remove every child node to prevent a double free
-	rootNode->removeAllChildNodes();
+	if (rootNode) {
+		rootNode->removeAllChildNodes();
+	}
 }
 
 /**
@@ -46,9 +53,12 @@ Game::~Game() {
  */
 void Game::startGame() {
 	tryStartGame();
-	lastProgressTime = QTime::currentTime();
+	simulation.stop();
+	random.seed(Settings::get()->getSeed());
 	std::ranges::for_each(getCurvers(), [](const std::unique_ptr<Curver> &c) { c->start(); });
 	itemFactory->resetRound();
+	// without a window there is no scene graph synchronization, so the game logic can run on its own thread
+	simulation.start(!window());
 	// 60 FPS = 16 ms interval
 	gameTimer.start(static_cast<int>(1000.f / Settings::get()->getUpdatesPerSecond()));
 }
@@ -73,6 +83,8 @@ void Game::processKey(Qt::Key key, bool release) {
  * @param port The port that the host is listening on
  */
 void Game::connectToHost(QString ip, int port) {
+	// a locally started game must not keep running next to the one of the host
+	simulation.stop();
 	client.connectToHost(ip, port);
 }
 
@@ -102,6 +114,7 @@ void Game::serverReListen(quint16 port) {
  * @brief Resets the entire game
  */
 void Game::resetGame() {
+	std::scoped_lock lock(PlayerModel::get()->mutex);
 	triggerResetRound();
 	std::ranges::for_each(getCurvers(), [](const auto &c) { c->totalScore = 0; });
 	winnerAnnounced = false;
@@ -121,13 +134,41 @@ Client *Game::getClient() {
  * @return Always return Game::rootNode
  */
 QSGNode *Game::updatePaintNode(QSGNode *, QQuickItem::UpdatePaintNodeData *) {
+	if (client.getJoinStatus() == Client::JoinStatus::JOINED) {
+		// the Server runs the game logic, the Curvers only follow its data, even if a local game was started before joining
+		if (triggerReset) {
+			resetRound();
+		}
+		std::ranges::for_each(getCurvers(), [](const auto &c) { c->animate(); });
+		// no time is simulated here, the Items sent by the Server follow the played back tick
+		itemFactory->follow(client.playbackTick());
+		if (client.interpolate()) {
+			// keep rendering until the playback caught up with the received data
+			QMetaObject::invokeMethod(this, &QQuickItem::update, Qt::QueuedConnection);
+		}
+	} else if (simulation.isStarted()) {
+		// the game logic touches the scene graph, so it must advance here instead of on its own thread
+		simulation.advance();
+	} else {
+		// the game logic does not run on its own here, e.g. as a client, but animations still need to progress
+		tick(0);
+	}
+	rootNode->markDirty(QSGNode::DirtyStateBit::DirtyGeometry);
+
+	return rootNode;
+}
+
+/**
+ * @brief Advances the game logic by a single fixed step
+ *
+ * This is called by Game::simulation, either from updatePaintNode() or from the simulation thread.
+ * @param deltat The length of the step in milliseconds
+ */
+void Game::tick(const float deltat) {
 	// check if round should be reset
 	if (triggerReset) {
 		resetRound();
 	}
-
-	int deltat = Util::getTimeDiff(lastProgressTime);
-	lastProgressTime = QTime::currentTime();
 	for (auto &c : getCurvers()) {
 		if (c->isAlive()) {
 			if (c->controller == Curver::Controller::CONTROLLER_BOT) {
@@ -136,18 +177,17 @@ QSGNode *Game::updatePaintNode(QSGNode *, QQuickItem::UpdatePaintNodeData *) {
 		}
 		c->progress(deltat, getCurvers());
 	}
-	itemFactory->update();
-	rootNode->markDirty(QSGNode::DirtyStateBit::DirtyGeometry);
-
-	return rootNode;
+	itemFactory->update(deltat);
 }
 
 /**
- * @brief Updates the game's logic respecting how much time actually passed by
+ * @brief Requests a new frame and broadcasts the current state
+ *
+ * The game logic itself runs in fixed steps, see Game::simulation.
  */
 void Game::progress() {
 	update();
-	server.broadcastCurverData();
+	server.broadcastCurverData(simulation.latestSnapshot());
 }
 
 /**
@@ -156,6 +196,7 @@ void Game::progress() {
  * This method taskes care of the score board and checks if a new round is due.
  */
 void Game::curverDied() {
+	std::scoped_lock lock(PlayerModel::get()->mutex);
 	std::ranges::for_each(getCurvers(), [](const auto &c) { if (c->isAlive()) c->increaseScore(); });
 	auto maxScorer = std::ranges::max_element(getCurvers());
 	if ((*maxScorer)->totalScore >= Settings::get()->getTargetScore() && !winnerAnnounced) {
@@ -176,15 +217,16 @@ void Game::curverDied() {
 void Game::resetRound() {
 	itemFactory->resetRound();
 	std::ranges::for_each(getCurvers(), [](const auto &c) { c->resetRound(); });
-	server.resetRound();
+	// the server learns about the reset from the snapshot of this tick, so it never sends the new round without the reset
+	simulation.startRound();
 	resetPending = false;
 	triggerReset = false;
 }
 
 /**
- * @brief Sets a flag so that the next update event iteration will reset the round
+ * @brief Sets a flag so that the next simulation tick will reset the round
  *
- * We cannot just immediately reset, because a round reset will touch some nodes, which must only happen inside the render thread.
+ * We cannot just immediately reset, because a round reset will touch some nodes, which must only happen inside of a simulation tick.
  */
 void Game::triggerResetRound() {
 	this->triggerReset = true;
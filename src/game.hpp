@@ -8,6 +8,7 @@
 #include <QSGGeometry>
 #include <QSGNode>
 #include <QTimer>
+#include <atomic>
 
 #include "bot.hpp"
 #include "curver.hpp"
@@ -16,6 +17,8 @@
 #include "models/playermodel.hpp"
 #include "network/client.hpp"
 #include "network/server.hpp"
+#include "random.hpp"
+#include "simulation.hpp"
 #include "wall.hpp"
 
 /**
@@ -60,23 +63,26 @@ private slots:
 	void tryStartGame();
 private:
 	std::vector<std::unique_ptr<Curver>> &getCurvers();
+	void tick(const float deltat);
 
 	/**
 	 * @brief The timer responsible for the game main loop
 	 */
 	QTimer gameTimer;
-	/**
-	 * @brief The time of the last game logic update
-	 */
-	QTime lastProgressTime;
 	/**
 	 * @brief The timer responsible for resetting the round after all players died
 	 */
 	QTimer resetRoundTimer;
 	/**
-	 * @brief The root node in the scene graph
+	 * @brief The root node in the scene graph, or \c nullptr on a headless server
 	 */
 	QSGNode *rootNode;
+	/**
+	 * @brief The random generator of this game
+	 *
+	 * It is seeded with Settings::getSeed() whenever the game starts, so the same seed always results in the same game.
+	 */
+	Random random;
 	/**
 	 * @brief The item factory of this game
 	 */
@@ -104,9 +110,15 @@ private:
 	/**
 	 * @brief Whether a round reset is currently pending in the queue
 	 */
-	bool resetPending = false;
+	std::atomic<bool> resetPending = false;
+	/**
+	 * @brief Whether a round reset must be triggered in the next simulation tick
+	 */
+	std::atomic<bool> triggerReset = false;
 	/**
-	 * @brief Whether a round reset must be triggered in the next update event loop iteration
+	 * @brief The simulation running the game logic
+	 *
+	 * Must be declared last, so that its thread stops before anything it touches is destroyed.
 	 */
-	bool triggerReset = false;
+	Simulation simulation;
 };
@@ -1,5 +1,9 @@
 #include "gamewatcher.hpp"
 
+#include <QTextStream>
+
+#include "lobby.hpp"
+
 /**
  * @brief Constructs a GameWatcher object and connects all signals of the commandline reader with slots related to the Game.
  * @param parent The parent object
@@ -19,6 +23,7 @@ GameWatcher::GameWatcher(QObject *parent)
 	connect(&cliReader, &CommandlineReader::removeBots, PlayerModel::get(), &PlayerModel::removeBots);
 	connect(&cliReader, &CommandlineReader::reset, &game, &Game::resetGame);
 	connect(&cliReader, &CommandlineReader::resize, Settings::get(), &Settings::setDimension);
+	connect(&cliReader, &CommandlineReader::seed, Settings::get(), &Settings::setSeed);
 	connect(&cliReader, &CommandlineReader::start, &game, &Game::startGame);
 	connect(&cliReader, &CommandlineReader::targetScore, Settings::get(), &Settings::setTargetScore);
 
@@ -30,9 +35,27 @@ GameWatcher::GameWatcher(QObject *parent)
  * @brief Starts the GameWatcher by parsing the commandline input.
  */
 void GameWatcher::start() {
+	// pass this seed with --seed to replay the game
+	qInfo() << "Random seed:" << Settings::get()->getSeed();
 	cliReader.runAsync();
 }
 
+/**
+ * @brief Lets the Server listen on a fixed port
+ * @param port The port to listen on
+ */
+void GameWatcher::listen(const quint16 port) {
+	game.serverReListen(port);
+}
+
+/**
+ * @brief Reports the number of players on the standard output whenever it changes, so that the Lobby running this room can balance the rooms
+ */
+void GameWatcher::reportPlayerCount() {
+	connect(PlayerModel::get(), &PlayerModel::playerModelChanged, this, &GameWatcher::printPlayerCount);
+	printPlayerCount();
+}
+
 /**
  * @brief Quits the whole operation and the program.
  */
@@ -48,3 +71,12 @@ void GameWatcher::quit() {
 void GameWatcher::printChatMessage(QString username, QString message) {
 	qInfo() << username << message;
 }
+
+/**
+ * @brief Prints the number of players that joined over the network, see Lobby::playerCountPrefix
+ */
+void GameWatcher::printPlayerCount() {
+	const auto &curvers = PlayerModel::get()->getCurvers();
+	const auto players = std::ranges::count_if(curvers, [](const auto &c) { return c->controller == Curver::Controller::CONTROLLER_REMOTE; });
+	QTextStream(stdout) << Lobby::playerCountPrefix << players << Qt::endl;
+}
@@ -13,9 +13,12 @@ class GameWatcher : public QObject {
 public:
 	explicit GameWatcher(QObject *parent = nullptr);
 	void start();
+	void listen(const quint16 port);
+	void reportPlayerCount();
 private slots:
 	void quit();
 	void printChatMessage(QString username, QString message);
+	void printPlayerCount();
 private:
 	/**
 	 * @brief The commandline reader interface
@@ -0,0 +1,342 @@
+#include "intersection.hpp"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define INTERSECTION_SSE2
+#include <immintrin.h>
+#endif
+#if defined(INTERSECTION_SSE2) && defined(__GNUC__)
+// AVX2 code is compiled per function, so that the binary still runs on CPUs without AVX2
+#define INTERSECTION_AVX2
+#endif
+
+namespace {
+
+/**
+ * @brief Checks if a single edge from c to d collides with a line
+ *
+ * This is the reference implementation, all SIMD implementations must return exactly the same result.
+ * @param l The line to check against
+ * @param cx The x coordinate of the start point of the edge
+ * @param cy The y coordinate of the start point of the edge
+ * @param dx The x coordinate of the end point of the edge
+ * @param dy The y coordinate of the end point of the edge
+ * @return \c True, iif the edge intersects with the line
+ */
+inline bool checkEdge(const Intersection::Line &l, const double cx, const double cy, const double dx, const double dy) {
+	/* Given a line (a -- b) and (c -- d), we find an intersection as follows:
+	 *
+	 * First compute the equation A*x + B*y = C for both lines
+	 * A = b.y - a.y
+	 * B = a.x - b.x
+	 * C = A*a.x + B*a.y
+	 *
+	 * Then for two lines 1 and 2 in this form, first check if
+	 * det := A1*B2 - A2*B1 == 0 => Lines are parallel
+	 * If this is the case, check if the lines intersect using a bounding rectangle
+	 *
+	 * Otherwise compute the location of the intersection as follows:
+	 * x := (B2*C1 - B1*C2)/det
+	 * y := (A1*C2 - A2*C1)/det
+	 *
+	 * Finally check if this intersection location is contained in both lines
+	*/
+	constexpr float epsilon = Intersection::epsilon;
+	const float secondA = dy - cy;
+	const float secondB = cx - dx;
+	const float secondC = secondA * cx + secondB * cy;
+	const float det = l.A * secondB - secondA * l.B;
+	if (static_cast<bool>(det)) {
+		// not parallel
+		const float x = (secondB * l.C - l.B * secondC) / det;
+		const float y = (l.A * secondC - secondA * l.C) / det;
+		// is the intersection location contained in both lines?
+		if (l.minX <= x && x <= l.maxX && l.minY <= y && y <= l.maxY &&
+			(std::min(cx, dx) - epsilon) <= x && (x <= std::max(cx, dx) + epsilon) &&
+			(std::min(cy, dy) - epsilon) <= y && (y <= std::max(cy, dy) + epsilon)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief Checks a range of edges one by one
+ * @param l The line to check against
+ * @param xs The x coordinates of all points
+ * @param ys The y coordinates of all points
+ * @param begin The first edge to check
+ * @param end The last edge to check (inclusive)
+ * @return \c True, iif any edge intersects with the line
+ */
+bool checkEdgesScalar(const Intersection::Line &l, const double *xs, const double *ys, size_t begin, size_t end) {
+	for (size_t i = begin; i <= end; ++i) {
+		if (checkEdge(l, xs[i - 2], ys[i - 2], xs[i], ys[i])) {
+			return true;
+		}
+	}
+	return false;
+}
+
+#ifdef INTERSECTION_SSE2
+/**
+ * @brief Checks which intersection locations are contained in their edges using SSE2
+ * @param cx The x coordinates of the start points of the edges
+ * @param cy The y coordinates of the start points of the edges
+ * @param dx The x coordinates of the end points of the edges
+ * @param dy The y coordinates of the end points of the edges
+ * @param x The x coordinates of the intersection locations
+ * @param y The y coordinates of the intersection locations
+ * @return A bit mask with one bit set for each contained location
+ */
+inline int onEdgesSse2(__m128d cx, __m128d cy, __m128d dx, __m128d dy, __m128d x, __m128d y) {
+	const __m128d epsilon = _mm_set1_pd(Intersection::epsilon);
+	__m128d result = _mm_and_pd(_mm_cmple_pd(_mm_sub_pd(_mm_min_pd(cx, dx), epsilon), x), _mm_cmple_pd(x, _mm_add_pd(_mm_max_pd(cx, dx), epsilon)));
+	result = _mm_and_pd(result, _mm_cmple_pd(_mm_sub_pd(_mm_min_pd(cy, dy), epsilon), y));
+	return _mm_movemask_pd(_mm_and_pd(result, _mm_cmple_pd(y, _mm_add_pd(_mm_max_pd(cy, dy), epsilon))));
+}
+
+/**
+ * @brief Checks a range of edges four at a time using SSE2
+ *
+ * The points are stored as doubles, so every step that the reference implementation performs in double precision is done with two double vectors,
+ * and every step in single precision is done with one float vector.
+ * @param l The line to check against
+ * @param xs The x coordinates of all points
+ * @param ys The y coordinates of all points
+ * @param begin The first edge to check
+ * @param end The last edge to check (inclusive)
+ * @return \c True, iif any edge intersects with the line
+ */
+bool checkEdgesSse2(const Intersection::Line &l, const double *xs, const double *ys, size_t begin, size_t end) {
+	const __m128 firstA = _mm_set1_ps(l.A);
+	const __m128 firstB = _mm_set1_ps(l.B);
+	const __m128 firstC = _mm_set1_ps(l.C);
+	const __m128 minX = _mm_set1_ps(l.minX);
+	const __m128 maxX = _mm_set1_ps(l.maxX);
+	const __m128 minY = _mm_set1_ps(l.minY);
+	const __m128 maxY = _mm_set1_ps(l.maxY);
+	size_t i = begin;
+	for (; i + 3 <= end; i += 4) {
+		// edges i and i+1 in the low half, edges i+2 and i+3 in the high half
+		const __m128d cxLo = _mm_loadu_pd(xs + i - 2), cxHi = _mm_loadu_pd(xs + i);
+		const __m128d cyLo = _mm_loadu_pd(ys + i - 2), cyHi = _mm_loadu_pd(ys + i);
+		const __m128d dxLo = _mm_loadu_pd(xs + i), dxHi = _mm_loadu_pd(xs + i + 2);
+		const __m128d dyLo = _mm_loadu_pd(ys + i), dyHi = _mm_loadu_pd(ys + i + 2);
+		const __m128 secondALo = _mm_cvtpd_ps(_mm_sub_pd(dyLo, cyLo)), secondAHi = _mm_cvtpd_ps(_mm_sub_pd(dyHi, cyHi));
+		const __m128 secondBLo = _mm_cvtpd_ps(_mm_sub_pd(cxLo, dxLo)), secondBHi = _mm_cvtpd_ps(_mm_sub_pd(cxHi, dxHi));
+		const __m128 secondCLo = _mm_cvtpd_ps(_mm_add_pd(_mm_mul_pd(_mm_cvtps_pd(secondALo), cxLo), _mm_mul_pd(_mm_cvtps_pd(secondBLo), cyLo)));
+		const __m128 secondCHi = _mm_cvtpd_ps(_mm_add_pd(_mm_mul_pd(_mm_cvtps_pd(secondAHi), cxHi), _mm_mul_pd(_mm_cvtps_pd(secondBHi), cyHi)));
+		const __m128 secondA = _mm_movelh_ps(secondALo, secondAHi);
+		const __m128 secondB = _mm_movelh_ps(secondBLo, secondBHi);
+		const __m128 secondC = _mm_movelh_ps(secondCLo, secondCHi);
+
+		const __m128 det = _mm_sub_ps(_mm_mul_ps(firstA, secondB), _mm_mul_ps(secondA, firstB));
+		const __m128 x = _mm_div_ps(_mm_sub_ps(_mm_mul_ps(secondB, firstC), _mm_mul_ps(firstB, secondC)), det);
+		const __m128 y = _mm_div_ps(_mm_sub_ps(_mm_mul_ps(firstA, secondC), _mm_mul_ps(secondA, firstC)), det);
+		__m128 inside = _mm_cmpneq_ps(det, _mm_setzero_ps());
+		inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmple_ps(minX, x), _mm_cmple_ps(x, maxX)));
+		inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmple_ps(minY, y), _mm_cmple_ps(y, maxY)));
+		if (!_mm_movemask_ps(inside)) {
+			continue;
+		}
+
+		// the containment in the edge is compared in double precision
+		const __m128d xLo = _mm_cvtps_pd(x), xHi = _mm_cvtps_pd(_mm_movehl_ps(x, x));
+		const __m128d yLo = _mm_cvtps_pd(y), yHi = _mm_cvtps_pd(_mm_movehl_ps(y, y));
+		const int edgeMask = onEdgesSse2(cxLo, cyLo, dxLo, dyLo, xLo, yLo) | onEdgesSse2(cxHi, cyHi, dxHi, dyHi, xHi, yHi) << 2;
+		if (_mm_movemask_ps(inside) & edgeMask) {
+			return true;
+		}
+	}
+	return i <= end && checkEdgesScalar(l, xs, ys, i, end);
+}
+#endif
+
+#ifdef INTERSECTION_AVX2
+/**
+ * @brief Checks which intersection locations are contained in their edges using AVX2
+ *
+ * Works exactly like onEdgesSse2(), just with twice the vector width.
+ * @param cx The x coordinates of the start points of the edges
+ * @param cy The y coordinates of the start points of the edges
+ * @param dx The x coordinates of the end points of the edges
+ * @param dy The y coordinates of the end points of the edges
+ * @param x The x coordinates of the intersection locations
+ * @param y The y coordinates of the intersection locations
+ * @return A bit mask with one bit set for each contained location
+ */
+__attribute__((target("avx2"))) inline int onEdgesAvx2(__m256d cx, __m256d cy, __m256d dx, __m256d dy, __m256d x, __m256d y) {
+	const __m256d epsilon = _mm256_set1_pd(Intersection::epsilon);
+	__m256d result = _mm256_and_pd(_mm256_cmp_pd(_mm256_sub_pd(_mm256_min_pd(cx, dx), epsilon), x, _CMP_LE_OQ), _mm256_cmp_pd(x, _mm256_add_pd(_mm256_max_pd(cx, dx), epsilon), _CMP_LE_OQ));
+	result = _mm256_and_pd(result, _mm256_cmp_pd(_mm256_sub_pd(_mm256_min_pd(cy, dy), epsilon), y, _CMP_LE_OQ));
+	return _mm256_movemask_pd(_mm256_and_pd(result, _mm256_cmp_pd(y, _mm256_add_pd(_mm256_max_pd(cy, dy), epsilon), _CMP_LE_OQ)));
+}
+
+/**
+ * @brief Combines two float vectors into one AVX vector
+ * @param lo The lower half
+ * @param hi The upper half
+ * @return The combined vector
+ */
+__attribute__((target("avx2"))) inline __m256 combine(__m128 lo, __m128 hi) {
+	return _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+}
+
+/**
+ * @brief Checks a range of edges eight at a time using AVX2
+ *
+ * Works exactly like checkEdgesSse2(), just with twice the vector width.
+ * @param l The line to check against
+ * @param xs The x coordinates of all points
+ * @param ys The y coordinates of all points
+ * @param begin The first edge to check
+ * @param end The last edge to check (inclusive)
+ * @return \c True, iif any edge intersects with the line
+ */
+__attribute__((target("avx2"))) bool checkEdgesAvx2(const Intersection::Line &l, const double *xs, const double *ys, size_t begin, size_t end) {
+	const __m256 firstA = _mm256_set1_ps(l.A);
+	const __m256 firstB = _mm256_set1_ps(l.B);
+	const __m256 firstC = _mm256_set1_ps(l.C);
+	const __m256 minX = _mm256_set1_ps(l.minX);
+	const __m256 maxX = _mm256_set1_ps(l.maxX);
+	const __m256 minY = _mm256_set1_ps(l.minY);
+	const __m256 maxY = _mm256_set1_ps(l.maxY);
+	size_t i = begin;
+	for (; i + 7 <= end; i += 8) {
+		// edges i to i+3 in the low half, edges i+4 to i+7 in the high half
+		const __m256d cxLo = _mm256_loadu_pd(xs + i - 2), cxHi = _mm256_loadu_pd(xs + i + 2);
+		const __m256d cyLo = _mm256_loadu_pd(ys + i - 2), cyHi = _mm256_loadu_pd(ys + i + 2);
+		const __m256d dxLo = _mm256_loadu_pd(xs + i), dxHi = _mm256_loadu_pd(xs + i + 4);
+		const __m256d dyLo = _mm256_loadu_pd(ys + i), dyHi = _mm256_loadu_pd(ys + i + 4);
+		const __m128 secondALo = _mm256_cvtpd_ps(_mm256_sub_pd(dyLo, cyLo)), secondAHi = _mm256_cvtpd_ps(_mm256_sub_pd(dyHi, cyHi));
+		const __m128 secondBLo = _mm256_cvtpd_ps(_mm256_sub_pd(cxLo, dxLo)), secondBHi = _mm256_cvtpd_ps(_mm256_sub_pd(cxHi, dxHi));
+		const __m128 secondCLo = _mm256_cvtpd_ps(_mm256_add_pd(_mm256_mul_pd(_mm256_cvtps_pd(secondALo), cxLo), _mm256_mul_pd(_mm256_cvtps_pd(secondBLo), cyLo)));
+		const __m128 secondCHi = _mm256_cvtpd_ps(_mm256_add_pd(_mm256_mul_pd(_mm256_cvtps_pd(secondAHi), cxHi), _mm256_mul_pd(_mm256_cvtps_pd(secondBHi), cyHi)));
+		const __m256 secondA = combine(secondALo, secondAHi);
+		const __m256 secondB = combine(secondBLo, secondBHi);
+		const __m256 secondC = combine(secondCLo, secondCHi);
+
+		const __m256 det = _mm256_sub_ps(_mm256_mul_ps(firstA, secondB), _mm256_mul_ps(secondA, firstB));
+		const __m256 x = _mm256_div_ps(_mm256_sub_ps(_mm256_mul_ps(secondB, firstC), _mm256_mul_ps(firstB, secondC)), det);
+		const __m256 y = _mm256_div_ps(_mm256_sub_ps(_mm256_mul_ps(firstA, secondC), _mm256_mul_ps(secondA, firstC)), det);
+		__m256 inside = _mm256_cmp_ps(det, _mm256_setzero_ps(), _CMP_NEQ_UQ);
+		inside = _mm256_and_ps(inside, _mm256_and_ps(_mm256_cmp_ps(minX, x, _CMP_LE_OQ), _mm256_cmp_ps(x, maxX, _CMP_LE_OQ)));
+		inside = _mm256_and_ps(inside, _mm256_and_ps(_mm256_cmp_ps(minY, y, _CMP_LE_OQ), _mm256_cmp_ps(y, maxY, _CMP_LE_OQ)));
+		if (!_mm256_movemask_ps(inside)) {
+			continue;
+		}
+
+		// the containment in the edge is compared in double precision
+		const __m256d xLo = _mm256_cvtps_pd(_mm256_castps256_ps128(x)), xHi = _mm256_cvtps_pd(_mm256_extractf128_ps(x, 1));
+		const __m256d yLo = _mm256_cvtps_pd(_mm256_castps256_ps128(y)), yHi = _mm256_cvtps_pd(_mm256_extractf128_ps(y, 1));
+		const int edgeMask = onEdgesAvx2(cxLo, cyLo, dxLo, dyLo, xLo, yLo) | onEdgesAvx2(cxHi, cyHi, dxHi, dyHi, xHi, yHi) << 4;
+		if (_mm256_movemask_ps(inside) & edgeMask) {
+			return true;
+		}
+	}
+	return i <= end && checkEdgesScalar(l, xs, ys, i, end);
+}
+#endif
+
+/**
+ * @brief The signature of an edge checking implementation
+ */
+using EdgeCheck = decltype(Intersection::Kernel::check);
+
+/**
+ * @brief Selects the fastest implementation that the CPU supports
+ * @return The selected implementation
+ */
+EdgeCheck selectKernel() {
+#ifdef INTERSECTION_AVX2
+	// this runs during static initialization, so the CPU detection may not be initialized yet
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		return checkEdgesAvx2;
+	}
+#endif
+#ifdef INTERSECTION_SSE2
+	return checkEdgesSse2;
+#else
+	return checkEdgesScalar;
+#endif
+}
+
+/**
+ * @brief The implementation in use
+ */
+const EdgeCheck kernel = selectKernel();
+
+}
+
+/**
+ * @brief Computes the line equation and the bounding rectangle of a line from a to b
+ * @param a The start point of the line
+ * @param b The end point of the line
+ * @return The line
+ */
+Intersection::Line Intersection::makeLine(QPointF a, QPointF b) {
+	Line l;
+	l.A = b.y() - a.y();
+	l.B = a.x() - b.x();
+	l.C = l.A * a.x() + l.B * a.y();
+	l.minX = std::min(a.x(), b.x()) - epsilon;
+	l.maxX = std::max(a.x(), b.x()) + epsilon;
+	l.minY = std::min(a.y(), b.y()) - epsilon;
+	l.maxY = std::max(a.y(), b.y()) + epsilon;
+	return l;
+}
+
+/**
+ * @brief Checks if any edge in a range collides with a line
+ *
+ * The edge with index i connects the points i-2 and i.
+ * @param line The line to check against, see makeLine()
+ * @param xs The x coordinates of all points
+ * @param ys The y coordinates of all points
+ * @param begin The first edge to check, must be at least 2
+ * @param end The last edge to check (inclusive)
+ * @return \c True, iif any edge intersects with the line
+ */
+bool Intersection::checkEdges(const Line &line, const double *xs, const double *ys, size_t begin, size_t end) {
+	return begin <= end && kernel(line, xs, ys, begin, end);
+}
+
+/**
+ * @brief Returns the name of the implementation selected for this CPU
+ * @return The name of the implementation
+ */
+const char *Intersection::kernelName() {
+#ifdef INTERSECTION_AVX2
+	if (kernel == checkEdgesAvx2) {
+		return "avx2";
+	}
+#endif
+#ifdef INTERSECTION_SSE2
+	if (kernel == checkEdgesSse2) {
+		return "sse2";
+	}
+#endif
+	return "scalar";
+}
+
+/**
+ * @brief Returns every implementation that this CPU supports, starting with the scalar reference implementation
+ *
+ * This allows comparing the implementations against each other, checkEdges() always uses the one named by kernelName().
+ * @return The supported implementations
+ */
+std::vector<Intersection::Kernel> Intersection::supportedKernels() {
+	std::vector<Kernel> result = {{"scalar", checkEdgesScalar}};
+#ifdef INTERSECTION_SSE2
+	result.push_back({"sse2", checkEdgesSse2});
+#endif
+#ifdef INTERSECTION_AVX2
+	if (__builtin_cpu_supports("avx2")) {
+		result.push_back({"avx2", checkEdgesAvx2});
+	}
+#endif
+	return result;
+}
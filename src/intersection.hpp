@@ -0,0 +1,73 @@
+#pragma once
+
+#include <QPointF>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Contains the line intersection test used for every collision check
+ *
+ * The edges are tested in batches with SIMD instructions, if the CPU supports them.
+ * The best available implementation is selected once at runtime, every implementation returns exactly the same results.
+ */
+namespace Intersection {
+/**
+ * @brief The tolerance of the intersection test
+ *
+ * epsilon is needed, because floating point operations are not that nice, when it comes to comparing them
+ */
+constexpr float epsilon = 0.015625;
+
+/**
+ * @brief A query line in the form A*x + B*y = C together with its bounding rectangle grown by Intersection::epsilon
+ */
+struct Line {
+	/**
+	 * @brief The A coefficient of the line equation
+	 */
+	float A;
+	/**
+	 * @brief The B coefficient of the line equation
+	 */
+	float B;
+	/**
+	 * @brief The C coefficient of the line equation
+	 */
+	float C;
+	/**
+	 * @brief The smallest x coordinate of the line minus epsilon
+	 */
+	float minX;
+	/**
+	 * @brief The largest x coordinate of the line plus epsilon
+	 */
+	float maxX;
+	/**
+	 * @brief The smallest y coordinate of the line minus epsilon
+	 */
+	float minY;
+	/**
+	 * @brief The largest y coordinate of the line plus epsilon
+	 */
+	float maxY;
+};
+
+/**
+ * @brief An implementation of checkEdges()
+ */
+struct Kernel {
+	/**
+	 * @brief The name of the implementation, see kernelName()
+	 */
+	const char *name;
+	/**
+	 * @brief Checks a non-empty range of edges, with the same parameters as checkEdges()
+	 */
+	bool (*check)(const Line &line, const double *xs, const double *ys, size_t begin, size_t end);
+};
+
+Line makeLine(QPointF a, QPointF b);
+bool checkEdges(const Line &line, const double *xs, const double *ys, size_t begin, size_t end);
+const char *kernelName();
+std::vector<Kernel> supportedKernels();
+}
@@ -5,11 +5,13 @@
 /**
  * @brief Constructs a ItemFactory
  * @param parentNode The parent node in the scene graph
+ * @param random The random generator of the game
  * @param parent The parent object
  */
-ItemFactory::ItemFactory(QSGNode *parentNode, QObject *parent)
+ItemFactory::ItemFactory(QSGNode *parentNode, Random *random, QObject *parent)
 	: QObject(parent) {
 	this->parentNode = parentNode;
+	this->random = random;
 }
 
 /**
@@ -17,6 +19,7 @@ ItemFactory::ItemFactory(QSGNode *parentNode, QObject *parent)
  */
 void ItemFactory::resetRound() {
 	items.clear();
+	grid.reset(Settings::get()->getDimension());
 	std::ranges::for_each(usedItems, [](auto &i) { i->defuse(); });
 	usedItems.clear();
 	prepareNextItem();
@@ -26,17 +29,29 @@ void ItemFactory::resetRound() {
  * @brief Updates the ItemFactory to check whether a new Item should spawn
  *
  * Also checks if any Curver triggers an Item
+ * @param deltat The length of the simulation tick in milliseconds, or \c 0 if no time was simulated
  */
-void ItemFactory::update() {
-	if (nextItemSpawn.isValid() && QTime::currentTime() >= nextItemSpawn) {
+void ItemFactory::update(const float deltat) {
+	if (deltat > 0) {
+		++tick;
+	}
+	if (nextItemSpawn && *nextItemSpawn <= tick) {
 		spawnItem();
 		prepareNextItem();
 	}
 	checkCollisions();
+	updateItems();
+}
 
-	// update all items
-	std::ranges::for_each(items, [](auto &i) { i->update(); });
-	std::ranges::for_each(usedItems, [](auto &i) { i->update(); });
+/**
+ * @brief Updates the Item instances integrated from a Server, without running any game logic
+ *
+ * A Client does not simulate any ticks, so the effects of triggered Item instances end according to the played back tick of the Server.
+ * @param tick The tick of the Server data that is currently played back
+ */
+void ItemFactory::follow(const quint64 tick) {
+	this->tick = tick;
+	updateItems();
 }
 
 /**
@@ -51,13 +66,17 @@ void ItemFactory::update() {
 void ItemFactory::integrateItem(bool spawned, unsigned int sequenceNumber, int which, QPointF pos, Item::AllowedUsers allowedUsers, int collectorIndex) {
 	if (spawned) {
 		// add the new spawned item
-		items.emplace_back(std::unique_ptr<Item>(ItemModel::get()->makePredefinedItem(parentNode, which, pos, allowedUsers, window)));
-		items.back()->sequenceNumber = sequenceNumber;
+		Item *item = ItemModel::get()->makePredefinedItem(parentNode, which, pos, allowedUsers, window);
+		item->sequenceNumber = sequenceNumber;
+		addItem(item);
 	} else {
 		auto it = std::ranges::find_if(items, [&](auto &i) { return i->sequenceNumber == sequenceNumber; });
 		if (it != items.end()) {
+			grid.remove(it->get());
 			if (collectorIndex != -1) {
-				(*it)->trigger(PlayerModel::get()->getCurvers()[collectorIndex]);
+				(*it)->trigger(PlayerModel::get()->getCurvers()[collectorIndex], tick);
+				// keep the Item until its effect ends
+				usedItems.emplace_back(std::move(*it));
 			}
 			items.erase(it);
 		}
@@ -76,7 +95,7 @@ void ItemFactory::setWindow(QQuickWindow *w) {
  * @brief Prepares a new Item spawn
  */
 void ItemFactory::prepareNextItem() {
-	nextItemSpawn = QTime::currentTime().addMSecs(Util::randInt(Settings::get()->getItemSpawnIntervalMin(), Settings::get()->getItemSpawnIntervalMax()));
+	nextItemSpawn = tick + Settings::get()->msecsToTicks(random->randInt(Settings::get()->getItemSpawnIntervalMin(), Settings::get()->getItemSpawnIntervalMax()));
 }
 
 /**
@@ -84,24 +103,47 @@ void ItemFactory::prepareNextItem() {
  */
 void ItemFactory::spawnItem() {
 	QPoint dimension = Settings::get()->getDimension();
-	items.emplace_back(std::unique_ptr<Item>(ItemModel::get()->makeRandomItem(parentNode, QPointF(Util::randInt(SPAWN_WALL_THRESHOLD, dimension.x() - SPAWN_WALL_THRESHOLD), Util::randInt(SPAWN_WALL_THRESHOLD, dimension.y() - SPAWN_WALL_THRESHOLD)), window)));
+	const int x = random->randInt(SPAWN_WALL_THRESHOLD, dimension.x() - SPAWN_WALL_THRESHOLD);
+	const QPointF pos(x, random->randInt(SPAWN_WALL_THRESHOLD, dimension.y() - SPAWN_WALL_THRESHOLD));
+	if (Item *item = ItemModel::get()->makeRandomItem(parentNode, pos, window, *random)) {
+		addItem(item);
+	}
 }
 
 /**
  * @brief Checks if any Curver is in range of any Item and triggers it accordingly
+ *
+ * Every Curver head only looks up the Item instances near it in ItemFactory::grid.
+ * An Item in range of several Curver instances goes to the one with the lowest index.
  */
 void ItemFactory::checkCollisions() {
-	auto itemIt = items.begin();
-	while (itemIt != items.end()) {
-		auto curverIt = std::ranges::find_if(PlayerModel::get()->getCurvers(), [&itemIt](auto &curver) { return (*itemIt)->isInRange(curver->getPos()); });
-		if (curverIt != PlayerModel::get()->getCurvers().end()) {
+	auto &curvers = PlayerModel::get()->getCurvers();
+	for (auto curverIt = curvers.begin(); curverIt != curvers.end(); ++curverIt) {
+		while (Item *item = grid.itemInRange((*curverIt)->getPos())) {
 			// trigger item
-			ItemModel::get()->itemSpawned(false, (*itemIt)->sequenceNumber, 0, QPointF(), Item::AllowedUsers::ALLOW_ALL, curverIt - PlayerModel::get()->getCurvers().begin());
-			(*itemIt)->trigger(*curverIt);
+			ItemModel::get()->itemSpawned(false, item->sequenceNumber, 0, QPointF(), Item::AllowedUsers::ALLOW_ALL, curverIt - curvers.begin());
+			item->trigger(*curverIt, tick);
+			grid.remove(item);
+			auto itemIt = std::ranges::find_if(items, [item](auto &i) { return i.get() == item; });
 			usedItems.emplace_back(std::move(*itemIt));
-			itemIt = items.erase(itemIt);
-		} else {
-			++itemIt;
+			items.erase(itemIt);
 		}
 	}
 }
+
+/**
+ * @brief Adds a spawned Item to the field
+ * @param item The new Item, which the ItemFactory takes ownership of
+ */
+void ItemFactory::addItem(Item *item) {
+	items.emplace_back(std::unique_ptr<Item>(item));
+	grid.insert(item);
+}
+
+/**
+ * @brief Updates all Item instances, which fades them and ends the effects that ran out
+ */
+void ItemFactory::updateItems() {
+	std::ranges::for_each(items, [this](auto &i) { i->update(tick); });
+	std::ranges::for_each(usedItems, [this](auto &i) { i->update(tick); });
+}
@@ -2,12 +2,14 @@
 
 #include <QObject>
 #include <QSGNode>
-#include <QTime>
+#include <optional>
 
 #include "items/cleaninstallitem.hpp"
 #include "items/speeditem.hpp"
+#include "itemgrid.hpp"
 #include "models/itemmodel.hpp"
 #include "models/playermodel.hpp"
+#include "random.hpp"
 #include "settings.hpp"
 #include "util.hpp"
 
@@ -17,10 +19,11 @@
 class ItemFactory : public QObject {
 	Q_OBJECT
 public:
-	explicit ItemFactory(QSGNode *parentNode, QObject *parent = nullptr);
+	explicit ItemFactory(QSGNode *parentNode, Random *random, QObject *parent = nullptr);
 
 	void resetRound();
-	void update();
+	void update(const float deltat);
+	void follow(const quint64 tick);
 public slots:
 	void integrateItem(bool spawned, unsigned int sequenceNumber, int which, QPointF pos, Item::AllowedUsers allowedUsers, int collectorIndex);
 	void setWindow(QQuickWindow *w);
@@ -29,19 +32,37 @@ private:
 	void prepareNextItem();
 	void spawnItem();
 	void checkCollisions();
+	void addItem(Item *item);
+	void updateItems();
 
 	/**
 	 * @brief The parent node in the scene graph
 	 */
 	QSGNode *parentNode;
 	/**
-	 * @brief The time of the next Item spawn
+	 * @brief The random generator of the game
 	 */
-	QTime nextItemSpawn;
+	Random *random;
+	/**
+	 * @brief The number of simulation ticks that the ItemFactory went through
+	 *
+	 * On a Client this follows the tick of the played back Server data instead, see follow().
+	 */
+	quint64 tick = 0;
+	/**
+	 * @brief The tick of the next Item spawn, see ItemFactory::tick, or nothing if no spawn is planned
+	 *
+	 * Spawns are planned in ticks instead of wall-clock time, so that a game with the same seed always draws the same random numbers.
+	 */
+	std::optional<quint64> nextItemSpawn;
 	/**
 	 * @brief All currently available visible Item instances
 	 */
 	std::vector<std::unique_ptr<Item>> items;
+	/**
+	 * @brief The Item instances of ItemFactory::items indexed by location
+	 */
+	ItemGrid grid;
 	/**
 	 * @brief All used Item instances waiting to be deleted
 	 */
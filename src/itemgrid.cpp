@@ -0,0 +1,116 @@
+#include "itemgrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "items/item.hpp"
+
+// larger than the trigger area of an Item, so that every Item covers at most four cells
+#define ITEM_GRID_CELL_SIZE 64.0
+
+ItemGrid::ItemGrid() {
+	cells.resize(1);
+}
+
+/**
+ * @brief Resizes the grid to cover the given arena dimension and removes all Item instances
+ * @param dimension The dimension of the game arena
+ *
+ * Positions outside of the arena are mapped to the border cells, so the grid stays correct, even if the dimension changes later on.
+ */
+void ItemGrid::reset(const QPoint dimension) {
+	columns = std::max(1, static_cast<int>(std::ceil(dimension.x() / ITEM_GRID_CELL_SIZE)));
+	rows = std::max(1, static_cast<int>(std::ceil(dimension.y() / ITEM_GRID_CELL_SIZE)));
+	cells.assign(static_cast<size_t>(columns) * rows, {});
+}
+
+/**
+ * @brief Removes all Item instances while keeping the allocated cells
+ */
+void ItemGrid::clear() {
+	std::ranges::for_each(cells, [](auto &c) { c.clear(); });
+}
+
+/**
+ * @brief Registers an Item in every cell that its trigger area overlaps
+ * @param item The Item to insert
+ */
+void ItemGrid::insert(Item *item) {
+	const QRect rect = cellsCovering(item->getTriggerArea());
+	for (int y = rect.top(); y <= rect.bottom(); ++y) {
+		for (int x = rect.left(); x <= rect.right(); ++x) {
+			cell(x, y).push_back(item);
+		}
+	}
+}
+
+/**
+ * @brief Removes an Item from every cell that it was registered in
+ * @param item The Item to remove
+ */
+void ItemGrid::remove(const Item *item) {
+	const QRect rect = cellsCovering(item->getTriggerArea());
+	for (int y = rect.top(); y <= rect.bottom(); ++y) {
+		for (int x = rect.left(); x <= rect.right(); ++x) {
+			std::erase(cell(x, y), item);
+		}
+	}
+}
+
+/**
+ * @brief Returns the oldest Item that a given point is in trigger range of
+ * @param p The point to check for, usually the head of a Curver
+ * @return The Item, or \c nullptr if \a p is not in range of any Item
+ */
+Item *ItemGrid::itemInRange(const QPointF p) const {
+	const auto &items = cell(column(p.x()), row(p.y()));
+	const auto it = std::ranges::find_if(items, [p](const Item *i) { return i->isInRange(p); });
+	return it != items.end() ? *it : nullptr;
+}
+
+/**
+ * @brief Returns the cells overlapped by an area
+ * @param area The area
+ * @return The overlapped cells, where each cell is one unit in the returned rectangle
+ */
+QRect ItemGrid::cellsCovering(const QRectF area) const {
+	return QRect(QPoint(column(area.left()), row(area.top())), QPoint(column(area.right()), row(area.bottom())));
+}
+
+/**
+ * @brief Returns the column containing a given x coordinate
+ * @param x The x coordinate
+ * @return The column, clamped to the grid
+ */
+int ItemGrid::column(const qreal x) const {
+	return static_cast<int>(std::clamp(std::floor(x / ITEM_GRID_CELL_SIZE), 0.0, columns - 1.0));
+}
+
+/**
+ * @brief Returns the row containing a given y coordinate
+ * @param y The y coordinate
+ * @return The row, clamped to the grid
+ */
+int ItemGrid::row(const qreal y) const {
+	return static_cast<int>(std::clamp(std::floor(y / ITEM_GRID_CELL_SIZE), 0.0, rows - 1.0));
+}
+
+/**
+ * @brief Returns a cell
+ * @param x The column of the cell
+ * @param y The row of the cell
+ * @return The Item instances registered in the cell
+ */
+std::vector<Item *> &ItemGrid::cell(const int x, const int y) {
+	return cells[static_cast<size_t>(y) * columns + x];
+}
+
+/**
+ * @brief Returns a cell
+ * @param x The column of the cell
+ * @param y The row of the cell
+ * @return The Item instances registered in the cell
+ */
+const std::vector<Item *> &ItemGrid::cell(const int x, const int y) const {
+	return cells[static_cast<size_t>(y) * columns + x];
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QPoint>
+#include <QPointF>
+#include <QRect>
+#include <vector>
+
+class Item;
+
+/**
+ * @brief A uniform grid over the game arena that indexes Item instances by location
+ *
+ * Every Item registers itself in the cells that its trigger area overlaps.
+ * Looking up the Item in range of a Curver head then only tests the few Item instances stored in the single cell containing the head,
+ * instead of every Item on the field.
+ */
+class ItemGrid {
+public:
+	explicit ItemGrid();
+
+	void reset(const QPoint dimension);
+	void clear();
+	void insert(Item *item);
+	void remove(const Item *item);
+	Item *itemInRange(const QPointF p) const;
+private:
+	QRect cellsCovering(const QRectF area) const;
+	int column(const qreal x) const;
+	int row(const qreal y) const;
+	std::vector<Item *> &cell(const int x, const int y);
+	const std::vector<Item *> &cell(const int x, const int y) const;
+
+	/**
+	 * @brief The number of columns in the grid
+	 */
+	int columns = 1;
+	/**
+	 * @brief The number of rows in the grid
+	 */
+	int rows = 1;
+	/**
+	 * @brief All cells stored row by row, each in the order that the Item instances were inserted
+	 */
+	std::vector<std::vector<Item *>> cells;
+};
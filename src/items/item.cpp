@@ -1,14 +1,13 @@
 #include "item.hpp"
 
-#include <QPainter>
-#include <quartz/codepoints.hpp>
+#include "itematlas.hpp"
 
 #define SIZE 12
 #define FADEDURATION 256
 
 /**
  * @brief Constructs a new Item instance
- * @param parentNode The parent node in the scene graph
+ * @param parentNode The parent node in the scene graph, or \c nullptr to not render the Item at all
  * @param iconName The path to the icon used as a texture
  * @param allowedUsers The allowed users for this Item
  * @param pos The location of this Item
@@ -20,32 +19,36 @@ Item::Item(QSGNode *parentNode, QString iconName, AllowedUsers allowedUsers, QPo
 	this->allowedUsers = allowedUsers;
 	this->pos = pos;
 
-	color = getColor();
+	startFade(true);
+	if (!parentNode || !window) {
+		return;
+	}
 	imgNode = window->createImageNode();
 	imgNode->setFiltering(QSGTexture::Linear);
 	imgNode->setMipmapFiltering(QSGTexture::Linear);
 	initTexture(window);
-	imgNode->setTexture(texture.get());
-	startFade(true);
 	fade();
 	parentNode->appendChildNode(imgNode);
 }
 
 Item::~Item() {
-	parentNode->removeChildNode(imgNode);
-	delete imgNode;
+	if (imgNode) {
+		parentNode->removeChildNode(imgNode);
+		delete imgNode;
+	}
 }
 
 /**
  * @brief Performs all updates on this Item
+ * @param tick The current tick of the ItemFactory
  */
-void Item::update() {
+void Item::update(const quint64 tick) {
 	// check if needs to fade
 	if (fadeStart.isValid()) {
 		fade();
 	}
 	// check if this item should be deactivated
-	if (active && unUseTime.isValid() && QTime::currentTime() > unUseTime) {
+	if (active && unUseTick && tick >= *unUseTick) {
 		defuse();
 	}
 }
@@ -62,15 +65,16 @@ void Item::defuse() {
 /**
  * @brief Triggers the Item
  * @param collector The collecting Curver
+ * @param tick The current tick of the ItemFactory
  */
-void Item::trigger(std::unique_ptr<Curver> &collector) {
+void Item::trigger(std::unique_ptr<Curver> &collector, const quint64 tick) {
 	this->collector = collector.get();
 
 	applyToAffected(&Item::use);
 	active = true;
 	if (this->activatedTime != 0) {
 		// has to be deactivated
-		unUseTime = QTime::currentTime().addMSecs(activatedTime);
+		unUseTick = tick + Settings::get()->msecsToTicks(activatedTime);
 	}
 	startFade(false);
 }
@@ -82,8 +86,10 @@ void Item::fade() {
 	float actualDuration = fadeStart.msecsTo(QTime::currentTime());
 	float factor = !fadeIn + (fadeIn - !fadeIn) * actualDuration / FADEDURATION;
 	factor = qMin(1.f, qMax(0.f, factor)); // 0 <= factor <= 1
-	imgNode->setRect(this->pos.x() - SIZE * factor, this->pos.y() - SIZE * factor, 2 * SIZE * factor, 2 * SIZE * factor);
-	imgNode->markDirty(QSGNode::DirtyGeometry);
+	if (imgNode) {
+		imgNode->setRect(this->pos.x() - SIZE * factor, this->pos.y() - SIZE * factor, 2 * SIZE * factor, 2 * SIZE * factor);
+		imgNode->markDirty(QSGNode::DirtyGeometry);
+	}
 	if (actualDuration > FADEDURATION) {
 		fadeStart = QTime();
 	}
@@ -114,10 +120,11 @@ void Item::unUse(Curver *) {
 }
 
 /**
- * @brief Returns the color of the Item
+ * @brief Returns the color of an Item
+ * @param allowedUsers The allowed users of the Item
  * @return The color
  */
-QColor Item::getColor() const {
+QColor Item::getColor(const AllowedUsers allowedUsers) {
 	switch (allowedUsers) {
 	case AllowedUsers::ALLOW_ALL:
 		return Util::getColor("Blue");
@@ -129,28 +136,16 @@ QColor Item::getColor() const {
 }
 
 /**
- * @brief Initializes the texture of the Item
- * @param window The window to create the texture in
+ * @brief Shows the icon of the Item from the ItemAtlas of the window
+ * @param window The window to render in
  */
 void Item::initTexture(QQuickWindow *window) {
 	if (Settings::get()->getOffscreen()) {
 		return;
 	}
-	constexpr const int res = 48;
-	QImage img = QImage(res, res, QImage::Format_RGB32);
-	img.fill(color); // fill with background color
-	QPainter painter(&img);
-	QFont font {"Material Symbols Outlined"};
-	font.setPixelSize(res);
-	painter.setFont(font);
-	painter.drawText(QRect(0, 0, res, res), Qt::AlignCenter, Codepoints::get()->icon(iconName));
-
-	// create the texture
-	assert(window);
-	texture = std::unique_ptr<QSGTexture>(window->createTextureFromImage(img, QQuickWindow::TextureHasMipmaps));
-	assert(texture);
-	texture->setFiltering(QSGTexture::Linear);
-	texture->setMipmapFiltering(QSGTexture::Linear);
+	const ItemAtlas &atlas = ItemAtlas::forWindow(window);
+	imgNode->setTexture(atlas.getTexture());
+	imgNode->setSourceRect(atlas.sourceRect(iconName, allowedUsers));
 }
 
 /**
@@ -166,6 +161,14 @@ bool Item::isInRange(QPointF p) const {
 	return false;
 }
 
+/**
+ * @brief Returns the area that a point has to be inside of to be in trigger range, see isInRange()
+ * @return The trigger area
+ */
+QRectF Item::getTriggerArea() const {
+	return QRectF(pos.x() - SIZE, pos.y() - SIZE, 2 * SIZE, 2 * SIZE);
+}
+
 /**
  * @brief Starts a visual fade of the Item
  * @param in Whether to fade in or out
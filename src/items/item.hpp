@@ -3,9 +3,11 @@
 #include <QImage>
 #include <QObject>
 #include <QPointF>
+#include <QRectF>
 #include <QQuickWindow>
 #include <QSGNode>
 #include <QSGTextureMaterial>
+#include <optional>
 
 #include "curver.hpp"
 #include "models/playermodel.hpp"
@@ -29,10 +31,12 @@ public:
 	explicit Item(QSGNode *parentNode, QString iconName, AllowedUsers allowedUsers, QPointF pos, QQuickWindow *window);
 	~Item();
 
-	void update();
+	void update(const quint64 tick);
 	void defuse();
-	void trigger(std::unique_ptr<Curver> &collector);
+	void trigger(std::unique_ptr<Curver> &collector, const quint64 tick);
 	bool isInRange(QPointF p) const;
+	QRectF getTriggerArea() const;
+	static QColor getColor(const AllowedUsers allowedUsers);
 
 	/**
 	 * @brief The sequence number of this Item
@@ -46,7 +50,6 @@ protected slots:
 protected:
 	virtual void use(Curver *);
 	virtual void unUse(Curver *);
-	QColor getColor() const;
 	void initTexture(QQuickWindow *window);
 	void startFade(bool in = true);
 	void applyToAffected(void (Item::*method)(Curver *curver));
@@ -77,24 +80,16 @@ protected:
 	 * @brief The Curver that collected the Item
 	 */
 	Curver *collector;
-	/**
-	 * @brief The texture of this Item
-	 */
-	std::unique_ptr<QSGTexture> texture;
 	/**
 	 * @brief The node displaying this Item in the scene graph
 	 */
-	QSGImageNode *imgNode;
-	/**
-	 * @brief The color of the Item
-	 */
-	QColor color;
+	QSGImageNode *imgNode = nullptr;
 	/**
-	 * @brief The time when this Item should deactivate after it was triggered
+	 * @brief The tick of the ItemFactory when this Item should deactivate after it was triggered
 	 *
-	 * If the item wasn't used yet, this is the null time.
+	 * If the item wasn't used yet or does not have to be deactivated, this is nothing.
 	 */
-	QTime unUseTime;
+	std::optional<quint64> unUseTick;
 	/**
 	 * @brief The point of time that the last fade began
 	 *
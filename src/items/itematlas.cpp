@@ -0,0 +1,90 @@
+#include "itematlas.hpp"
+
+#include <QPainter>
+#include <algorithm>
+#include <array>
+#include <quartz/codepoints.hpp>
+
+#include "models/itemmodel.hpp"
+
+// the resolution of a single icon in the atlas
+#define ICON_RESOLUTION 48
+// the margin around every icon, that keeps the smaller mipmap levels from blending neighbouring icons
+#define ICON_PADDING 8
+
+std::unordered_map<QQuickWindow *, std::unique_ptr<ItemAtlas>> ItemAtlas::atlases;
+std::mutex ItemAtlas::atlasesMutex;
+
+/**
+ * @brief Renders every icon in every color and uploads the result as a single texture
+ * @param window The window to create the texture in
+ */
+ItemAtlas::ItemAtlas(QQuickWindow *window) {
+	for (const auto &iconName : ItemModel::get()->getIconNames()) {
+		if (!rows.contains(iconName)) {
+			rows.insert(iconName, rows.size());
+		}
+	}
+	const std::array allowedUsers = {Item::AllowedUsers::ALLOW_ALL, Item::AllowedUsers::ALLOW_OTHERS, Item::AllowedUsers::ALLOW_COLLECTOR};
+	constexpr const int tile = ICON_RESOLUTION + 2 * ICON_PADDING;
+	QImage img = QImage(allowedUsers.size() * tile, std::max<int>(rows.size(), 1) * tile, QImage::Format_RGB32);
+	QPainter painter(&img);
+	QFont font {"Material Symbols Outlined"};
+	font.setPixelSize(ICON_RESOLUTION);
+	painter.setFont(font);
+	for (const auto &[iconName, row] : rows.asKeyValueRange()) {
+		for (const auto &a : allowedUsers) {
+			// the padding has the background color, so that the edges of the icon do not blend with anything else
+			const QRect rect(static_cast<int>(a) * tile, row * tile, tile, tile);
+			painter.fillRect(rect, Item::getColor(a));
+			painter.drawText(rect, Qt::AlignCenter, Codepoints::get()->icon(iconName));
+		}
+	}
+	painter.end();
+
+	texture = std::unique_ptr<QSGTexture>(window->createTextureFromImage(img, QQuickWindow::TextureHasMipmaps));
+	assert(texture);
+	texture->setFiltering(QSGTexture::Linear);
+	texture->setMipmapFiltering(QSGTexture::Linear);
+}
+
+/**
+ * @brief Returns the atlas of a window and creates it, if it does not exist yet
+ *
+ * This must be called with the scene graph of \a window being initialized, e.g. while updating the paint nodes.
+ * @param window The window
+ * @return The atlas
+ */
+ItemAtlas &ItemAtlas::forWindow(QQuickWindow *window) {
+	const std::scoped_lock lock(atlasesMutex);
+	auto it = atlases.find(window);
+	if (it == atlases.end()) {
+		it = atlases.emplace(window, std::make_unique<ItemAtlas>(window)).first;
+		// the texture belongs to the scene graph, so it must be released on the render thread before the scene graph is gone
+		QObject::connect(window, &QQuickWindow::sceneGraphInvalidated, window, [window]() {
+			const std::scoped_lock lock(atlasesMutex);
+			atlases.erase(window);
+		}, Qt::DirectConnection);
+	}
+	return *it->second;
+}
+
+/**
+ * @brief Returns the texture containing all icons
+ * @return The texture
+ */
+QSGTexture *ItemAtlas::getTexture() const {
+	return texture.get();
+}
+
+/**
+ * @brief Returns the part of the texture showing an icon in the color of the allowed users
+ * @param iconName The name of the icon, which must be the icon of an ItemModel::ItemConfig
+ * @param allowedUsers The allowed users, which determine the background color
+ * @return The source rectangle in pixels
+ */
+QRectF ItemAtlas::sourceRect(const QString &iconName, const Item::AllowedUsers allowedUsers) const {
+	assert(rows.contains(iconName));
+	constexpr const int tile = ICON_RESOLUTION + 2 * ICON_PADDING;
+	return QRectF(static_cast<int>(allowedUsers) * tile + ICON_PADDING, rows.value(iconName) * tile + ICON_PADDING, ICON_RESOLUTION, ICON_RESOLUTION);
+}
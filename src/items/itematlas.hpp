@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QHash>
+#include <QQuickWindow>
+#include <QRectF>
+#include <QSGTexture>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "item.hpp"
+
+/**
+ * @brief A single texture per window holding the icon of every Item in every color
+ *
+ * Rendering an icon glyph and uploading it as a new texture is too slow to do on every Item spawn in the middle of a game.
+ * Instead the atlas renders every icon of the ItemModel once for each Item::AllowedUsers color, when the first Item is shown in a window,
+ * and every Item then only displays its part of the shared texture.
+ */
+class ItemAtlas {
+public:
+	explicit ItemAtlas(QQuickWindow *window);
+
+	static ItemAtlas &forWindow(QQuickWindow *window);
+	QSGTexture *getTexture() const;
+	QRectF sourceRect(const QString &iconName, const Item::AllowedUsers allowedUsers) const;
+private:
+	/**
+	 * @brief The texture containing all icons
+	 */
+	std::unique_ptr<QSGTexture> texture;
+	/**
+	 * @brief The row of every icon in the texture, each color has its own column
+	 */
+	QHash<QString, int> rows;
+
+	/**
+	 * @brief The atlas of every window, which is released as soon as the scene graph of the window is
+	 */
+	static std::unordered_map<QQuickWindow *, std::unique_ptr<ItemAtlas>> atlases;
+	/**
+	 * @brief Protects ItemAtlas::atlases, because every window may have its own render thread
+	 */
+	static std::mutex atlasesMutex;
+};
@@ -0,0 +1,174 @@
+#include "lobby.hpp"
+
+#include <QTextStream>
+#include <QTimer>
+#include <algorithm>
+
+#include "network/network.hpp"
+#include "settings.hpp"
+
+// the time that a Client has to leave the Lobby after it was redirected
+#define REDIRECT_TIMEOUT 5000
+// the time that a room has to quit, before it is killed
+#define ROOM_QUIT_TIMEOUT 3000
+
+/**
+ * @brief Constructs a Lobby
+ * @param port The port that Clients connect to, the rooms use the ports following it
+ * @param roomCount The number of rooms
+ * @param parent The parent object
+ */
+Lobby::Lobby(const quint16 port, const int roomCount, QObject *parent)
+	: QObject(parent), port(port), rooms(roomCount) {
+	for (size_t i = 0; i < rooms.size(); ++i) {
+		rooms[i].port = port + 1 + i;
+		// every room plays a different game, but the whole Lobby is still reproducible with a single seed
+		rooms[i].seed = Settings::get()->getSeed() + i;
+	}
+	connect(&tcpServer, &QTcpServer::newConnection, this, &Lobby::newConnection);
+	connect(this, &Lobby::lineEntered, this, &Lobby::forwardLine);
+}
+
+/**
+ * @brief Destroys the Lobby and every room that is still running
+ */
+Lobby::~Lobby() {
+	for (auto &room : rooms) {
+		if (room.process && room.process->state() != QProcess::NotRunning) {
+			room.process->disconnect(this);
+			room.process->terminate();
+			if (!room.process->waitForFinished(ROOM_QUIT_TIMEOUT)) {
+				room.process->kill();
+				room.process->waitForFinished();
+			}
+		}
+	}
+}
+
+/**
+ * @brief Starts every room, listens for Clients and reads commands from the terminal
+ * @return Whether the Lobby could listen on its port
+ */
+bool Lobby::start() {
+	if (!tcpServer.listen(QHostAddress::Any, port)) {
+		qCritical() << "Lobby cannot listen on port" << port << tcpServer.errorString();
+		return false;
+	}
+	qInfo() << "Lobby running on port" << port << "with" << rooms.size() << "rooms on the ports" << port + 1 << "to" << port + rooms.size();
+	// pass this seed with --seed to replay the games of all rooms
+	qInfo() << "Random seed:" << Settings::get()->getSeed();
+	std::ranges::for_each(rooms, [this](auto &room) { startRoom(room); });
+	auto future = QtConcurrent::run([&]() { this->readLines(); });
+	return true;
+}
+
+/**
+ * @brief Redirects a new Client to the room with the fewest players
+ *
+ * Clients that were redirected recently count as well, because they may not have joined their room yet.
+ */
+void Lobby::newConnection() {
+	while (tcpServer.hasPendingConnections()) {
+		QTcpSocket *socket = tcpServer.nextPendingConnection();
+		connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+		// the Client leaves by itself, but must not occupy the Lobby forever
+		QTimer::singleShot(REDIRECT_TIMEOUT, socket, [socket]() { socket->abort(); });
+		auto &room = *std::ranges::min_element(rooms, {}, [](const auto &r) { return r.players + r.pendingRedirects; });
+		++room.pendingRedirects;
+		QTimer::singleShot(REDIRECT_TIMEOUT, this, [&room]() { if (room.pendingRedirects > 0) --room.pendingRedirects; });
+		Packet::ServerRedirect p;
+		p.port = room.port;
+		p.sendPacket(socket);
+	}
+}
+
+/**
+ * @brief Forwards a line entered into the terminal to the rooms
+ *
+ * A line of the form "/room <index> <command>" only goes to a single room, every other line goes to all rooms.
+ * @param line The entered line
+ */
+void Lobby::forwardLine(QString line) {
+	const auto parts = line.split(' ', Qt::SkipEmptyParts);
+	if (parts.size() > 2 && parts.first() == "/room") {
+		bool ok = false;
+		const int index = parts[1].toInt(&ok);
+		if (!ok || index < 0 || index >= static_cast<int>(rooms.size())) {
+			qInfo() << "There is no room" << parts[1];
+			return;
+		}
+		rooms[index].process->write(QStringList(parts.begin() + 2, parts.end()).join(' ').toUtf8() + '\n');
+		return;
+	}
+	if (line.trimmed() == "/quit") {
+		quitting = true;
+	}
+	for (auto &room : rooms) {
+		room.process->write(line.toUtf8() + '\n');
+	}
+}
+
+/**
+ * @brief Starts the child process of a room
+ * @param room The room to start
+ */
+void Lobby::startRoom(Room &room) {
+	room.process = std::make_unique<QProcess>();
+	// the rooms log to the terminal of the Lobby, but commands pass through forwardLine() and the standard output reports the players
+	room.process->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+	room.process->setInputChannelMode(QProcess::ManagedInputChannel);
+	connect(room.process.get(), &QProcess::readyReadStandardOutput, this, [this, &room]() { readPlayerCount(room); });
+	connect(room.process.get(), &QProcess::finished, this, [this, &room]() { roomFinished(room); }, Qt::QueuedConnection);
+	room.process->start(QCoreApplication::applicationFilePath(), {"-platform", "offscreen", "--port", QString::number(room.port), "--seed", QString::number(room.seed), "--room"});
+}
+
+/**
+ * @brief Called, when the child process of a room finished
+ *
+ * A room that crashed is restarted, unless the user asked to quit.
+ * Once every room quit, the Lobby quits as well.
+ * @param room The room that finished
+ */
+void Lobby::roomFinished(Room &room) {
+	if (!quitting) {
+		qWarning() << "Room on port" << room.port << "finished unexpectedly, restarting it";
+		room.players = 0;
+		room.pendingRedirects = 0;
+		startRoom(room);
+	} else if (std::ranges::all_of(rooms, [](const auto &r) { return r.process->state() == QProcess::NotRunning; })) {
+		QCoreApplication::quit();
+	}
+}
+
+/**
+ * @brief Reads the number of players that a room reported on its standard output
+ * @param room The room that wrote to its standard output
+ */
+void Lobby::readPlayerCount(Room &room) {
+	while (room.process->canReadLine()) {
+		const QString line = QString::fromUtf8(room.process->readLine()).trimmed();
+		if (line.startsWith(playerCountPrefix)) {
+			bool ok = false;
+			const size_t players = line.mid(qstrlen(playerCountPrefix)).toULongLong(&ok);
+			if (ok) {
+				room.players = players;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Reads lines from stdin until the user enters "/quit"
+ *
+ * This runs on a separate thread and hands every line to the thread of the Lobby.
+ */
+void Lobby::readLines() {
+	QTextStream stdInput(stdin);
+	QString line;
+	while (stdInput.readLineInto(&line)) {
+		lineEntered(line);
+		if (line.trimmed() == "/quit") {
+			break;
+		}
+	}
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <QObject>
+#include <QProcess>
+#include <QTcpServer>
+#include <QtConcurrent/QtConcurrent>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Hosts several headless games, so called rooms, behind a single port
+ *
+ * The game state lives in process-wide singletons like PlayerModel, ItemModel and Settings, so every room is a headless child process of its own.
+ * Every room therefore runs its own event loop and the operating system spreads the rooms across all cores.
+ * The Lobby listens on the shared port and redirects every Client to the room with the fewest players with a Packet::ServerRedirect.
+ * Every room reports its number of players on its standard output, while its log output on the standard error is forwarded to the terminal.
+ * Commands entered into the terminal are forwarded to the rooms.
+ */
+class Lobby : public QObject {
+	Q_OBJECT
+public:
+	explicit Lobby(const quint16 port, const int roomCount, QObject *parent = nullptr);
+	~Lobby();
+
+	bool start();
+
+	/**
+	 * @brief The prefix of the lines that a room writes to its standard output to report its number of players
+	 */
+	static constexpr char playerCountPrefix[] = "players ";
+signals:
+	/**
+	 * @brief Emitted when the user entered a line into the terminal
+	 * @param line The line without the line break
+	 */
+	void lineEntered(QString line);
+private slots:
+	void newConnection();
+	void forwardLine(QString line);
+private:
+	/**
+	 * @brief A headless child process hosting a single game
+	 */
+	struct Room {
+		/**
+		 * @brief The port that the room listens on
+		 */
+		quint16 port;
+		/**
+		 * @brief The child process
+		 */
+		std::unique_ptr<QProcess> process;
+		/**
+		 * @brief The seed of the random generator of the room, derived from the seed of the Lobby
+		 */
+		quint64 seed;
+		/**
+		 * @brief The number of players that the room reported last
+		 */
+		size_t players = 0;
+		/**
+		 * @brief The number of Clients that were redirected to the room within the last REDIRECT_TIMEOUT milliseconds
+		 *
+		 * These may not have joined yet, so they are not part of Room::players.
+		 */
+		size_t pendingRedirects = 0;
+	};
+
+	void startRoom(Room &room);
+	void roomFinished(Room &room);
+	void readPlayerCount(Room &room);
+	void readLines();
+
+	/**
+	 * @brief The port that Clients connect to
+	 */
+	quint16 port;
+	/**
+	 * @brief The server accepting the Clients
+	 */
+	QTcpServer tcpServer;
+	/**
+	 * @brief The rooms, which listen on the ports following Lobby::port
+	 */
+	std::vector<Room> rooms;
+	/**
+	 * @brief Whether the user asked to quit, so that finished rooms are not restarted
+	 */
+	bool quitting = false;
+};
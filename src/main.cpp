@@ -2,9 +2,12 @@
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
 #include <QQuickStyle>
+#include <QThread>
+#include <limits>
 
 #include "game.hpp"
 #include "gamewatcher.hpp"
+#include "lobby.hpp"
 #include "models/chatmodel.hpp"
 #include "models/itemmodel.hpp"
 #include "models/playermodel.hpp"
@@ -33,11 +36,67 @@ int main(int argc, char *argv[]) {
 	parser.setApplicationDescription("Quickcurver");
 	parser.addHelpOption();
 	parser.addVersionOption();
+	const QCommandLineOption seedOption("seed", "Seeds the random generator, so that games can be reproduced.", "seed");
+	parser.addOption(seedOption);
+	const QCommandLineOption portOption("port", "Lets a headless server listen on this port.", "port");
+	parser.addOption(portOption);
+	const QCommandLineOption roomsOption("rooms", "Hosts this many headless games on the ports following --port, which redirects joining players to them. 0 hosts one game per core.", "count");
+	parser.addOption(roomsOption);
+	QCommandLineOption roomOption("room", "Reports the number of players on the standard output, used by the rooms of --rooms.");
+	roomOption.setFlags(QCommandLineOption::HiddenFromHelp);
+	parser.addOption(roomOption);
 	parser.process(app);
+	if (parser.isSet(seedOption)) {
+		bool ok = false;
+		const quint64 seed = parser.value(seedOption).toULongLong(&ok);
+		if (!ok) {
+			qCritical() << "Invalid seed" << parser.value(seedOption);
+			return 1;
+		}
+		Settings::get()->setSeed(seed);
+	}
+
+	quint16 port = 0;
+	if (parser.isSet(portOption)) {
+		bool ok = false;
+		port = parser.value(portOption).toUShort(&ok);
+		if (!ok) {
+			qCritical() << "Invalid port" << parser.value(portOption);
+			return 1;
+		}
+	}
+
+	// lobby hosting several headless servers
+	if (parser.isSet(roomsOption)) {
+		bool ok = false;
+		int rooms = parser.value(roomsOption).toInt(&ok);
+		if (!ok || rooms < 0) {
+			qCritical() << "Invalid number of rooms" << parser.value(roomsOption);
+			return 1;
+		}
+		if (rooms == 0) {
+			rooms = QThread::idealThreadCount();
+		}
+		if (port == 0 || port + rooms > std::numeric_limits<quint16>::max()) {
+			qCritical() << "The rooms need a port with" << rooms << "free ports following it";
+			return 1;
+		}
+		Lobby lobby(port, rooms);
+		if (!lobby.start()) {
+			return 1;
+		}
+		return app.exec();
+	}
 
 	// headless server
 	if (Settings::get()->getOffscreen()) {
 		GameWatcher gameWatcher;
+		if (port) {
+			gameWatcher.listen(port);
+		}
+		if (parser.isSet(roomOption)) {
+			gameWatcher.reportPlayerCount();
+		}
 		gameWatcher.start();
 		return app.exec();
 	}
@@ -15,6 +15,7 @@ int ItemModel::rowCount(const QModelIndex &) const {
  * @return The data
  */
 QVariant ItemModel::data(const QModelIndex &index, int role) const {
+	std::scoped_lock lock(mutex);
 	const auto &itemConfig = itemConfigs[index.row()];
 	switch (role) {
 	case NameRole:
@@ -49,7 +50,10 @@ void ItemModel::setProbability(const int row, const float probability) {
 	if (row < 0 || static_cast<size_t>(row) >= itemConfigs.size() || probability < 0 || probability > 1) {
 		return;
 	}
+	// the Simulation may spawn an Item at the same time
+	std::scoped_lock lock(mutex);
 	itemConfigs[static_cast<size_t>(row)].probability = probability;
+	cumulativeProbabilities = accumulateProbabilities();
 }
 
 /**
@@ -58,25 +62,65 @@ void ItemModel::setProbability(const int row, const float probability) {
  * @param allowedUsers The allowed users for this Item
  */
 void ItemModel::setAllowedUsers(const int row, const int allowedUsers) {
+	std::scoped_lock lock(mutex);
 	itemConfigs[static_cast<unsigned long>(row)].allowedUsers = static_cast<Item::AllowedUsers>(allowedUsers);
 }
 
+/**
+ * @brief Returns the icon names of all Item configurations
+ * @return The icon names, which may contain duplicates
+ */
+std::vector<QString> ItemModel::getIconNames() const {
+	std::vector<QString> result;
+	std::ranges::transform(itemConfigs, std::back_inserter(result), &ItemConfig::iconName);
+	return result;
+}
+
 /**
  * @brief Creates a random Item at a given position
  * @param parentNode The parent node in the scene graph
  * @param pos The location of the Item
  * @param win The window to render in
- * @return The just created Item
- */
-Item *ItemModel::makeRandomItem(QSGNode *parentNode, QPointF pos, QQuickWindow *win) {
-	float totalProbability = Util::accumulate(itemConfigs, 0.f);
-	std::vector<ItemConfig> partialSums = itemConfigs;
-	Util::partial_sum(itemConfigs, partialSums);
-	float randValue = Util::rand() * totalProbability;
-	auto it = std::ranges::find_if(partialSums, [randValue](auto &item) { return randValue < item.probability; });
-	auto *result = (this->*it->constructor)(parentNode, it->iconName, it->allowedUsers, pos, win);
+ * @param random The random generator to choose the Item with
+ * @return The just created Item, or \c nullptr if every Item has a probability of zero
+ */
+Item *ItemModel::makeRandomItem(QSGNode *parentNode, QPointF pos, QQuickWindow *win, Random &random) {
+	size_t which;
+	Item::AllowedUsers allowedUsers;
+	{
+		std::scoped_lock lock(mutex);
+		const float totalProbability = cumulativeProbabilities.back();
+		const float randValue = random.rand() * totalProbability;
+		if (totalProbability <= 0) {
+			// every Item is disabled
+			return nullptr;
+		}
+		// the first Item whose cumulative probability exceeds the random value
+		auto it = std::ranges::upper_bound(cumulativeProbabilities, randValue);
+		if (it == cumulativeProbabilities.end()) {
+			// rounding pushed the random value up to the total, so take the last Item that can spawn at all
+			it = std::ranges::lower_bound(cumulativeProbabilities, totalProbability);
+		}
+		which = it - cumulativeProbabilities.begin();
+		allowedUsers = itemConfigs[which].allowedUsers;
+	}
+	const auto &conf = itemConfigs[which];
+	auto *result = (this->*conf.constructor)(parentNode, conf.iconName, allowedUsers, pos, win);
 	result->sequenceNumber = ++sequenceNumber;
-	itemSpawned(true, result->sequenceNumber, it - partialSums.begin(), pos, it->allowedUsers, -1);
+	itemSpawned(true, result->sequenceNumber, which, pos, allowedUsers, -1);
+	return result;
+}
+
+/**
+ * @brief Sums up the spawn probabilities of all Item configurations
+ *
+ * Random Item spawns search the result, so it must be updated whenever a configuration changes.
+ * @return The sum of the probabilities of every configuration and all configurations before it
+ */
+std::vector<float> ItemModel::accumulateProbabilities() const {
+	std::vector<float> result;
+	result.reserve(itemConfigs.size());
+	std::ranges::transform(itemConfigs, std::back_inserter(result), [sum = 0.f](const auto &c) mutable { return sum += c.probability; });
 	return result;
 }
 
@@ -90,7 +134,7 @@ Item *ItemModel::makeRandomItem(QSGNode *parentNode, QPointF pos, QQuickWindow *
  * @return The just created Item
  */
 Item *ItemModel::makePredefinedItem(QSGNode *parentNode, int which, QPointF pos, Item::AllowedUsers allowedUsers, QQuickWindow *win) {
-	auto conf = itemConfigs[which];
+	const auto &conf = itemConfigs[which];
 	return (this->*conf.constructor)(parentNode, conf.iconName, allowedUsers, pos, win);
 }
 
@@ -184,25 +228,3 @@ Item *ItemModel::makeSlowItem(QSGNode *parentNode, QString iconName, Item::Allow
 Item *ItemModel::makeGhostItem(QSGNode *parentNode, QString iconName, Item::AllowedUsers allowedUsers, QPointF pos, QQuickWindow *win) {
 	return new GhostItem(parentNode, iconName, allowedUsers, pos, win);
 }
-
-/**
- * @brief Adds two probabilities
- * @param a A given initial probability
- * @param b The ItemModel::ItemConfig containing a probability
- * @return The accumulated probability
- */
-float operator+(const float &a, const ItemModel::ItemConfig &b) {
-	return a + b.probability;
-}
-
-/**
- * @brief Adds two probabilities
- * @param a A configuration with a probability
- * @param b Another configuration with a probability
- * @return The accumulated probability
- */
-ItemModel::ItemConfig operator+(const ItemModel::ItemConfig &a, const ItemModel::ItemConfig &b) {
-	ItemModel::ItemConfig result = b;
-	result.probability = a.probability + b;
-	return result;
-}
@@ -2,6 +2,7 @@
 
 #include <QAbstractListModel>
 #include <QSGNode>
+#include <mutex>
 
 #include "items/agileitem.hpp"
 #include "items/cleaninstallitem.hpp"
@@ -11,6 +12,7 @@
 #include "items/item.hpp"
 #include "items/slowitem.hpp"
 #include "items/speeditem.hpp"
+#include "random.hpp"
 
 /**
  * @brief A model containing all Item configurations
@@ -31,8 +33,9 @@ public:
 
 	Q_INVOKABLE void setProbability(const int row, const float probability);
 	Q_INVOKABLE void setAllowedUsers(const int row, const int allowedUsers);
+	std::vector<QString> getIconNames() const;
 
-	Item *makeRandomItem(QSGNode *parentNode, QPointF pos, QQuickWindow *win);
+	Item *makeRandomItem(QSGNode *parentNode, QPointF pos, QQuickWindow *win, Random &random);
 	Item *makePredefinedItem(QSGNode *parentNode, int which, QPointF pos, Item::AllowedUsers allowedUsers, QQuickWindow *win);
 	/**
 	 * @brief This struct contains all configuration options for a Item
@@ -103,11 +106,23 @@ private:
 		{&ItemModel::makeSlowItem, "Freeze", "Decreases speed", 0.1, Item::AllowedUsers::ALLOW_OTHERS, "fast_rewind"},
 		{&ItemModel::makeGhostItem, "Ghost", "Booh!", 0.0, Item::AllowedUsers::ALLOW_OTHERS, "mystery"},
 	};
+	/**
+	 * @brief The cumulative spawn probabilities of ItemModel::itemConfigs, see accumulateProbabilities()
+	 */
+	std::vector<float> cumulativeProbabilities = accumulateProbabilities();
+	/**
+	 * @brief Guards the probabilities and allowed users of ItemModel::itemConfigs together with ItemModel::cumulativeProbabilities
+	 *
+	 * They are changed on the main thread, while the Simulation may spawn an Item on its own thread.
+	 */
+	mutable std::mutex mutex;
 	/**
 	 * @brief The sequence number of the last spawned Item
 	 */
 	unsigned int sequenceNumber = 0;
 
+	std::vector<float> accumulateProbabilities() const;
+
 	// item constructors
 	Item *makeSpeedItem(QSGNode *parentNode, QString iconName, Item::AllowedUsers allowedUsers, QPointF pos, QQuickWindow *win);
 	Item *makeCleanInstallItem(QSGNode *parentNode, QString iconName, Item::AllowedUsers allowedUsers, QPointF pos, QQuickWindow *win);
@@ -118,5 +133,3 @@ private:
 	Item *makeGhostItem(QSGNode *parentNode, QString iconName, Item::AllowedUsers allowedUsers, QPointF pos, QQuickWindow *win);
 };
 
-float operator+(const float &a, const ItemModel::ItemConfig &b);
-ItemModel::ItemConfig operator+(const ItemModel::ItemConfig &a, const ItemModel::ItemConfig &b);
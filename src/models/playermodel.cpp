@@ -1,5 +1,7 @@
 #include "playermodel.hpp"
 
+#include "network/network.hpp"
+
 /**
  * @brief Returns the number of rows in this model
  * @return The row count
@@ -50,8 +52,9 @@ QHash<int, QByteArray> PlayerModel::roleNames() const {
  * @brief Appends a new player to this model
  */
 void PlayerModel::appendPlayer() {
+	std::scoped_lock lock(mutex);
 	beginResetModel();
-	m_data.push_back(std::make_unique<Curver>(rootNode));
+	m_data.push_back(std::make_unique<Curver>(rootNode, random));
 	m_data.back()->userName = "Player " + QString::number(m_data.size());
 	connect(m_data.back().get(), &Curver::died, this, &PlayerModel::processDeath);
 	endResetModel();
@@ -71,6 +74,7 @@ void PlayerModel::appendBot() {
  * @param row The index of the player
  */
 void PlayerModel::removePlayer(int row) {
+	std::scoped_lock lock(mutex);
 	beginResetModel();
 	m_data.erase(m_data.begin() + row);
 	endResetModel();
@@ -137,6 +141,7 @@ void PlayerModel::setUserName(int row, QString username) {
  * @param ctrl The new controller
  */
 void PlayerModel::setController(int row, int ctrl) {
+	std::scoped_lock lock(mutex);
 	m_data[static_cast<unsigned long>(row)]->controller = static_cast<Curver::Controller>(ctrl);
 	dataChanged(index(row, 0), index(row, 0), QVector<int>() = {ControllerRole});
 	playerModelChanged();
@@ -150,6 +155,14 @@ void PlayerModel::setRootNode(QSGNode *rootNode) {
 	this->rootNode = rootNode;
 }
 
+/**
+ * @brief Sets the random generator that new Curver instances use
+ * @param random The random generator of the game
+ */
+void PlayerModel::setRandom(Random *random) {
+	this->random = random;
+}
+
 /**
  * @brief Returns all players as a Curver vector
  * @return All players
@@ -159,36 +172,37 @@ std::vector<std::unique_ptr<Curver>> &PlayerModel::getCurvers() {
 }
 
 /**
- * @brief Serializes this PlayerModel
- * @param out The stream to serialize into
+ * @brief Serializes this PlayerModel into the data sent over the network
+ * @param players Is filled with every player, the capacity of the vector is reused
  */
-void PlayerModel::serialize(QDataStream &out) const {
-	out << static_cast<unsigned>(m_data.size());
-	for (unsigned long i = 0; i < m_data.size(); ++i) {
+void PlayerModel::serialize(std::vector<Packet::Player> &players) const {
+	std::scoped_lock lock(mutex);
+	players.resize(m_data.size());
+	for (size_t i = 0; i < m_data.size(); ++i) {
 		const std::unique_ptr<Curver> &c = m_data[i];
-		out << c->userName << c->getColor() << c->roundScore << c->totalScore << static_cast<uint8_t>(c->controller) << static_cast<uint8_t>(c->isAlive());
+		players[i] = {c->userName, c->getColor(), c->roundScore, c->totalScore, c->controller, c->isAlive()};
 	}
 }
 
 /**
- * @brief Parses a PlayerModel from a stream
- * @param in The stream to parse from
+ * @brief Parses a PlayerModel from the data received over the network
+ * @param players Every player
  */
-void PlayerModel::parse(QDataStream &in) {
+void PlayerModel::parse(const std::vector<Packet::Player> &players) {
+	std::scoped_lock lock(mutex);
 	beginResetModel();
-	unsigned size;
-	in >> size;
-	m_data.resize(size);
-	for (auto &c : m_data) {
+	m_data.resize(players.size());
+	for (size_t i = 0; i < players.size(); ++i) {
+		auto &c = m_data[i];
 		if (!c) {
-			c = std::make_unique<Curver>(rootNode);
+			c = std::make_unique<Curver>(rootNode, random);
 		}
-		QColor color;
-		uint8_t ctrl, isAlive;
-		in >> c->userName >> color >> c->roundScore >> c->totalScore >> ctrl >> isAlive;
-		c->setColor(color);
-		c->controller = static_cast<Curver::Controller>(ctrl);
-		c->setAlive(static_cast<bool>(isAlive));
+		c->userName = players[i].userName;
+		c->setColor(players[i].color);
+		c->roundScore = players[i].roundScore;
+		c->totalScore = players[i].totalScore;
+		c->controller = players[i].controller;
+		c->setAlive(players[i].isAlive);
 	}
 	endResetModel();
 }
@@ -198,6 +212,7 @@ void PlayerModel::parse(QDataStream &in) {
  * @return The last added Curver
  */
 Curver *PlayerModel::getNewPlayer() {
+	std::scoped_lock lock(mutex);
 	appendPlayer();
 	return m_data.back().get();
 }
@@ -224,6 +239,7 @@ void PlayerModel::processDeath() {
  * @brief Removes all bots
  */
 void PlayerModel::removeBots() {
+	std::scoped_lock lock(mutex);
 	for (size_t i = 0; i < m_data.size(); ++i) {
 		if (m_data[i]->controller == Curver::Controller::CONTROLLER_BOT) {
 			this->removePlayer(i);
@@ -3,12 +3,17 @@
 #include <QAbstractListModel>
 #include <QHash>
 #include <QSGNode>
+#include <mutex>
 #include <quartz/macros.hpp>
 #include <vector>
 
 #include "curver.hpp"
 #include "gui.hpp"
 
+namespace Packet {
+struct Player;
+}
+
 /**
  * @brief A model containing all players
  */
@@ -34,11 +39,19 @@ public:
 	Q_INVOKABLE void setController(int row, int ctrl);
 
 	void setRootNode(QSGNode *rootNode);
+	void setRandom(Random *random);
 	std::vector<std::unique_ptr<Curver>> &getCurvers();
-	void serialize(QDataStream &out) const;
-	void parse(QDataStream &in);
+	void serialize(std::vector<Packet::Player> &players) const;
+	void parse(const std::vector<Packet::Player> &players);
 	Curver *getNewPlayer();
 	void forceRefresh();
+
+	/**
+	 * @brief Guards all players against concurrent access
+	 *
+	 * The Simulation holds this mutex during every tick, so it must be held whenever the players are changed from another thread.
+	 */
+	mutable std::recursive_mutex mutex;
 public slots:
 	void processDeath();
 	void removeBots();
@@ -77,5 +90,9 @@ private:
 	/**
 	 * @brief The root node in the scene graph
 	 */
-	QSGNode *rootNode;
+	QSGNode *rootNode = nullptr;
+	/**
+	 * @brief The random generator handed to every new Curver
+	 */
+	Random *random = nullptr;
 };
@@ -1,10 +1,15 @@
 #include "client.hpp"
 
+#include <ranges>
+
 #define PING_INTERVAL 5000
 #define JOIN_TIMEOUT 30000
+// must cover at least the history of the Server
+#define FRAME_HISTORY_SIZE 64
+// the number of the latest unconfirmed inputs repeated in every ClientCurverRotation
+#define INPUT_REDUNDANCY 4
 
 Client::Client() {
-	in.setDevice(&tcpSocket);
 	connect(&tcpSocket, &QTcpSocket::errorOccurred, this, &Client::socketError);
 	connect(&tcpSocket, &QTcpSocket::connected, this, &Client::socketConnected);
 	connect(&tcpSocket, &QTcpSocket::disconnected, this, &Client::socketDisconnected);
@@ -38,7 +43,7 @@ Client::JoinStatus Client::getJoinStatus() const {
  */
 void Client::connectToHost(QString addr, quint16 port) {
 	this->serverAddress = {QHostAddress(), port};
-	joinTimeoutTimer.start();
+	forgetServer();
 	// first look up the hostname
 	setJoinStatus(JoinStatus::DNS_PENDING);
 	QHostInfo::lookupHost(addr, this, &Client::dnsFinished);
@@ -72,17 +77,36 @@ void Client::sendPlayerModel() {
  * @param release Whether the key was pressed or released
  */
 void Client::processKey(Qt::Key key, bool release) {
-	Packet::ClientCurverRotation p;
+	Curver::Rotation rotation;
 	if (release) {
-		p.rotation = Curver::Rotation::ROTATE_NONE;
+		rotation = Curver::Rotation::ROTATE_NONE;
 	} else {
 		// TODO: Allow custom keys
 		if (key == Qt::Key_Left)
-			p.rotation = Curver::Rotation::ROTATE_LEFT;
+			rotation = Curver::Rotation::ROTATE_LEFT;
 		else
-			p.rotation = Curver::Rotation::ROTATE_RIGHT;
+			rotation = Curver::Rotation::ROTATE_RIGHT;
 	}
-	p.sendPacket(&tcpSocket);
+	// the input takes effect locally right away, see interpolate()
+	prediction.input(rotation, predictedTick());
+	sendInputs();
+}
+
+/**
+ * @brief Sends the latest inputs, that the Server did not confirm yet, over UDP
+ *
+ * Every datagram repeats up to INPUT_REDUNDANCY inputs, so the Server still gets an input, if the datagram carrying it is lost.
+ */
+void Client::sendInputs() {
+	const auto &inputs = prediction.getInputs();
+	if (inputs.empty()) {
+		return;
+	}
+	Packet::ClientCurverRotation p;
+	const size_t count = std::min<size_t>(inputs.size(), INPUT_REDUNDANCY);
+	std::ranges::transform(inputs | std::views::drop(inputs.size() - count), std::back_inserter(p.rotations), &Prediction::Input::rotation);
+	p.sequence = inputs.back().sequence;
+	p.sendPacketUdp(&udpSocket, serverAddress);
 }
 
 /**
@@ -91,9 +115,49 @@ void Client::processKey(Qt::Key key, bool release) {
 void Client::pingServer() {
 	Packet::Ping p;
 	p.delta = ping;
+	p.playerId = playerId;
 	p.sendPacketUdp(&udpSocket, serverAddress);
 }
 
+/**
+ * @brief Moves the Curvers along the received data up to the current playback time
+ *
+ * This must be called for every frame, see InterpolationBuffer.
+ * @return \c True, iif there is received data that was not displayed yet, so another frame is needed
+ */
+bool Client::interpolate() {
+	const bool pending = interpolationBuffer.advance(playback);
+	auto &curvers = PlayerModel::get()->getCurvers();
+	const int ownIndex = prediction.getCurverIndex();
+	for (const auto &s : playback) {
+		if (s.positions.size() != curvers.size()) {
+			// invalid size, can be UDP related
+			continue;
+		}
+		for (uint i = 0; i < curvers.size(); ++i) {
+			// the own Curver is predicted instead
+			if (static_cast<int>(i) != ownIndex) {
+				curvers[i]->appendPoint(s.positions[i], s.changingSegment[i]);
+			}
+		}
+	}
+	if (ownIndex >= 0 && static_cast<size_t>(ownIndex) < curvers.size()) {
+		Curver &own = *curvers[ownIndex];
+		for (const auto &[pos, changingSegment] : prediction.takeConfirmedPath()) {
+			own.appendPoint(pos, changingSegment);
+		}
+		if (own.isAlive()) {
+			prediction.predict(predictedTick(), predictedPath);
+		} else {
+			predictedPath.clear();
+		}
+		own.setPredictedPath(predictedPath);
+		// the predicted head moves with every frame
+		return own.isAlive() || pending;
+	}
+	return pending;
+}
+
 /**
  * @brief Called, when a socket error occurred
  */
@@ -106,9 +170,8 @@ void Client::socketError(QAbstractSocket::SocketError) {
  * @brief Called, when the socket has connected
  */
 void Client::socketConnected() {
-	// TCP connection successful, now try UDP
+	// TCP connection successful, UDP is tried as soon as the Server sent the player id
 	setJoinStatus(JoinStatus::UDP_PENDING);
-	pingServer();
 }
 
 /**
@@ -123,17 +186,22 @@ void Client::socketDisconnected() {
  * @brief Called, when there is new data available on the socket
  */
 void Client::socketReadyRead() {
-	bool illformedPacket = false;
-	while (tcpSocket.bytesAvailable() && !illformedPacket) {
-		in.startTransaction();
-		auto packet = Packet::AbstractPacket::receivePacket(in, InstanceType::Server);
-		if (in.commitTransaction()) {
+	tcpFrames.append(tcpSocket);
+	QByteArray frame;
+	while (tcpFrames.next(frame)) {
+		QDataStream in(frame);
+		auto packet = Packet::AbstractPacket::receivePacket(in, InstanceType::Server, packets);
+		if (in.status() == QDataStream::Ok) {
 			handlePacket(packet);
 		} else {
+			// the frame tells where the next packet starts, so only this one is lost
 			qInfo() << "Received ill-formed packet";
-			illformedPacket = true;
 		}
 	}
+	if (tcpFrames.isCorrupt()) {
+		qInfo() << "Received an invalid frame, closing the connection";
+		tcpSocket.abort();
+	}
 }
 
 /**
@@ -154,7 +222,7 @@ void Client::udpSocketReadyRead() {
 		udpSocket.readDatagram(datagram.data(), datagram.size());
 		QDataStream udpStream(&datagram, QIODevice::ReadOnly);
 		udpStream.startTransaction();
-		auto packet = Packet::AbstractPacket::receivePacket(udpStream, InstanceType::Server);
+		auto packet = Packet::AbstractPacket::receivePacket(udpStream, InstanceType::Server, packets);
 		if (udpStream.commitTransaction()) {
 			handlePacket(packet);
 		} else {
@@ -182,6 +250,22 @@ void Client::handleDns(QHostInfo info) {
 	tcpSocket.connectToHost(serverAddress.addr, serverAddress.port);
 }
 
+/**
+ * @brief Leaves a Lobby and joins the room that it redirected the Client to
+ * @param port The port of the room on the same host as the Lobby
+ */
+void Client::redirect(const quint16 port) {
+	{
+		// leaving the Lobby is not a failure
+		const QSignalBlocker blocker(tcpSocket);
+		tcpSocket.abort();
+	}
+	this->serverAddress.port = port;
+	forgetServer();
+	setJoinStatus(JoinStatus::TCP_PENDING);
+	tcpSocket.connectToHost(serverAddress.addr, serverAddress.port);
+}
+
 /**
  * @brief Handles a join timeout
  */
@@ -196,7 +280,7 @@ void Client::handleJoinTimeout() {
  * @brief Processes an already received packet
  * @param p The packet that was received
  */
-void Client::handlePacket(std::unique_ptr<Packet::AbstractPacket> &p) {
+void Client::handlePacket(Packet::AbstractPacket *p) {
 	// First handle flags
 	if (p->start) {
 		Gui::getSingleton().startGame();
@@ -207,38 +291,75 @@ void Client::handlePacket(std::unique_ptr<Packet::AbstractPacket> &p) {
 	switch (static_cast<Packet::ServerTypes>(p->type)) {
 	case Packet::ServerTypes::Chat_Message:
 		{
-			auto *chatMsg = (Packet::ServerChatMsg *) p.get();
+			auto *chatMsg = (Packet::ServerChatMsg *) p;
 			ChatModel::get()->appendMessage(chatMsg->username, chatMsg->message);
 			break;
 		}
 	case Packet::ServerTypes::PlayerModelEdit:
 		{
-			auto *playerModel = (Packet::ServerPlayerModel *) p.get();
+			auto *playerModel = (Packet::ServerPlayerModel *) p;
 			playerModel->extract();
 			break;
 		}
 	case Packet::ServerTypes::CurverData:
 		{
-			auto *curverData = (Packet::ServerCurverData *) p.get();
-			curverData->extract();
+			auto *curverData = (Packet::ServerCurverData *) p;
+			if (curverData->reset) {
+				// the trails of the old round must not be continued
+				interpolationBuffer.restart(curverData->tick);
+				prediction.restart(curverData->tick);
+			}
+			if (!curverData->resolve(frameHistory)) {
+				// the frame that the deltas refer to is gone, the next acknowledgement will fix this
+				break;
+			}
+			curverData->extract(interpolationBuffer);
+			if (curverData->curverIndex >= 0) {
+				prediction.confirm(curverData->tick, curverData->motion, curverData->inputSequence, curverData->changingSegment[curverData->curverIndex], curverData->curverIndex);
+				// until the Server confirms the inputs, they are repeated with every Curver data received
+				sendInputs();
+			}
 			updateGraphics();
+			if (frameHistory.empty() || frameHistory.back().tick < curverData->tick) {
+				frameHistory.push_back(curverData->frame());
+				if (frameHistory.size() > FRAME_HISTORY_SIZE) {
+					frameHistory.pop_front();
+				}
+				Packet::SnapshotAck ack;
+				ack.tick = curverData->tick;
+				ack.sendPacketUdp(&udpSocket, serverAddress);
+			}
 			break;
 		}
 	case Packet::ServerTypes::ItemData:
 		{
-			auto *itemData = (Packet::ServerItemData *) p.get();
+			auto *itemData = (Packet::ServerItemData *) p;
 			integrateItem(itemData->spawned, itemData->sequenceNumber, itemData->which, itemData->pos, itemData->allowedUsers, itemData->collectorIndex);
 			break;
 		}
 	case Packet::ServerTypes::SettingsType:
 		{
-			auto *settingsData = (Packet::ServerSettingsData *) p.get();
+			auto *settingsData = (Packet::ServerSettingsData *) p;
 			settingsData->extract();
 			break;
 		}
+	case Packet::ServerTypes::Welcome:
+		{
+			playerId = ((Packet::ServerWelcome *) p)->playerId;
+			// the player id ties our UDP address to the TCP connection
+			pingServer();
+			break;
+		}
+	case Packet::ServerTypes::Redirect:
+		{
+			const quint16 port = ((Packet::ServerRedirect *) p)->port;
+			// the socket must not be closed while its data is being read
+			QMetaObject::invokeMethod(this, [this, port]() { redirect(port); }, Qt::QueuedConnection);
+			break;
+		}
 	case Packet::ServerTypes::Pong:
 		{
-			auto *pong = (Packet::Pong *) p.get();
+			auto *pong = (Packet::Pong *) p;
 			ping = Util::getTimeDiff(pong->sent);
 			this->curverIndex = pong->curverIndex;
 			pong->extract();
@@ -256,6 +377,37 @@ void Client::handlePacket(std::unique_ptr<Packet::AbstractPacket> &p) {
 	}
 }
 
+/**
+ * @brief Forgets everything received from the previous Server and restarts the join timeout
+ */
+void Client::forgetServer() {
+	playerId = 0;
+	// frames of another server are meaningless
+	frameHistory.clear();
+	tcpFrames.clear();
+	interpolationBuffer.clear();
+	prediction.clear();
+	joinTimeoutTimer.start();
+}
+
+/**
+ * @brief Estimates the tick at which an input sent right now takes effect on the Server
+ *
+ * The estimated tick that the Server is sending right now is one-way delay behind it, and the input needs another one to get there.
+ * @return The tick, which is fractional in between two ticks
+ */
+double Client::predictedTick() const {
+	return interpolationBuffer.serverTick() + ping * Settings::get()->getUpdatesPerSecond() / 1000.0;
+}
+
+/**
+ * @brief Returns the tick of the Server data that is currently played back
+ * @return The tick, see InterpolationBuffer::playbackTick()
+ */
+quint64 Client::playbackTick() const {
+	return interpolationBuffer.playbackTick();
+}
+
 /**
  * @brief Sets the join status
  * @param s The new join status
@@ -4,7 +4,9 @@
 #include <QTimer>
 #include <QtNetwork>
 
+#include "framebuffer.hpp"
 #include "network.hpp"
+#include "prediction.hpp"
 
 /**
  * @brief A Client network instance
@@ -38,6 +40,8 @@ public:
 	void sendPlayerModel();
 	void processKey(Qt::Key key, bool release);
 	void pingServer();
+	bool interpolate();
+	quint64 playbackTick() const;
 signals:
 	/**
 	 * @brief Emitted when a new Item has to be integrated into the Game
@@ -82,9 +86,13 @@ private slots:
 
 	void handleDns(QHostInfo info);
 	void handleJoinTimeout();
+	void redirect(const quint16 port);
 private:
-	void handlePacket(std::unique_ptr<Packet::AbstractPacket> &p);
+	void handlePacket(Packet::AbstractPacket *p);
+	void forgetServer();
 	void setJoinStatus(const JoinStatus s);
+	double predictedTick() const;
+	void sendInputs();
 	/**
 	 * @brief The TCP socket to communicate with
 	 */
@@ -94,9 +102,13 @@ private:
 	 */
 	QUdpSocket udpSocket;
 	/**
-	 * @brief A data stream belonging to Client::socket
+	 * @brief The bytes received on Client::tcpSocket, that are split into packets
 	 */
-	QDataStream in;
+	FrameBuffer tcpFrames;
+	/**
+	 * @brief The instances that received packets are parsed into
+	 */
+	Packet::PacketPool packets;
 	/**
 	 * @brief The address of the server to connect to
 	 */
@@ -122,4 +134,28 @@ private:
 	 * @brief The index of the client in the server curver array
 	 */
 	int curverIndex = -1;
+	/**
+	 * @brief The player id that the Server assigned to this Client, or \c 0 if there is none yet
+	 */
+	quint32 playerId = 0;
+	/**
+	 * @brief The most recently received frames, which the Server encodes Curver data against
+	 */
+	std::deque<Packet::CurverFrame> frameHistory;
+	/**
+	 * @brief The received Curver data, which is played back with a delay to hide network jitter
+	 */
+	InterpolationBuffer interpolationBuffer;
+	/**
+	 * @brief The snapshots returned by the last playback step, kept to reuse their allocation
+	 */
+	std::vector<Snapshot> playback;
+	/**
+	 * @brief The prediction of the Curver of this Client
+	 */
+	Prediction prediction;
+	/**
+	 * @brief The path returned by the last prediction, kept to reuse its allocation
+	 */
+	std::vector<QPointF> predictedPath;
 };
@@ -0,0 +1,150 @@
+#include "datagrambatch.hpp"
+
+#ifdef Q_OS_LINUX
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#endif
+
+/**
+ * @brief Queues a datagram
+ * @param datagram The payload to send
+ * @param address The receiver of the datagram
+ */
+void DatagramBatch::add(QByteArray datagram, const FullNetworkAddress &address) {
+	datagrams.push_back({std::move(datagram), QByteArray(), address});
+}
+
+/**
+ * @brief Queues a datagram made of two parts, which are sent without copying them into a single buffer
+ * @param head The first part of the payload
+ * @param tail The second part of the payload
+ * @param address The receiver of the datagram
+ */
+void DatagramBatch::add(QByteArray head, QByteArray tail, const FullNetworkAddress &address) {
+	datagrams.push_back({std::move(head), std::move(tail), address});
+}
+
+/**
+ * @brief Sends every queued datagram and empties the batch
+ * @param socket The bound socket to send with
+ */
+void DatagramBatch::send(QUdpSocket &socket) {
+	sendFallback(socket, sendNative(socket));
+	// keeps the capacity for the next batch
+	datagrams.clear();
+}
+
+/**
+ * @brief Sends the queued datagrams one by one using Qt
+ * @param socket The socket to send with
+ * @param first The index of the first datagram that still has to be sent
+ */
+void DatagramBatch::sendFallback(QUdpSocket &socket, const size_t first) {
+	for (size_t i = first; i < datagrams.size(); ++i) {
+		const auto &d = datagrams[i];
+		socket.writeDatagram(d.tail.isEmpty() ? d.data : d.data + d.tail, d.address.addr, d.address.port);
+	}
+}
+
+#ifdef Q_OS_LINUX
+/**
+ * @brief Converts a network address to the representation of the operating system
+ * @param address The address to convert
+ * @param family The address family of the sending socket
+ * @param result Is filled with the converted address
+ * @param length Is set to the length of \a result
+ * @return \c True, iif the address can be reached by a socket of the given family
+ *
+ * A dual-stack IPv6 socket reaches IPv4 addresses by their IPv4-mapped IPv6 address.
+ */
+static bool toSockaddr(const FullNetworkAddress &address, const int family, sockaddr_storage &result, socklen_t &length) {
+	std::memset(&result, 0, sizeof(result));
+	bool isIPv4 = false;
+	const quint32 ipv4 = address.addr.toIPv4Address(&isIPv4);
+	if (family == AF_INET) {
+		if (!isIPv4) {
+			return false;
+		}
+		auto *in = reinterpret_cast<sockaddr_in *>(&result);
+		in->sin_family = AF_INET;
+		in->sin_port = htons(address.port);
+		in->sin_addr.s_addr = htonl(ipv4);
+		length = sizeof(sockaddr_in);
+		return true;
+	} else if (family == AF_INET6) {
+		auto *in6 = reinterpret_cast<sockaddr_in6 *>(&result);
+		in6->sin6_family = AF_INET6;
+		in6->sin6_port = htons(address.port);
+		if (isIPv4) {
+			// ::ffff:a.b.c.d
+			in6->sin6_addr.s6_addr[10] = 0xff;
+			in6->sin6_addr.s6_addr[11] = 0xff;
+			const quint32 networkOrder = htonl(ipv4);
+			std::memcpy(in6->sin6_addr.s6_addr + 12, &networkOrder, sizeof(networkOrder));
+		} else {
+			const Q_IPV6ADDR ipv6 = address.addr.toIPv6Address();
+			std::memcpy(in6->sin6_addr.s6_addr, ipv6.c, sizeof(ipv6.c));
+			in6->sin6_scope_id = address.addr.scopeId().toUInt();
+		}
+		length = sizeof(sockaddr_in6);
+		return true;
+	}
+	return false;
+}
+
+/**
+ * @brief Sends as many queued datagrams as possible with sendmmsg()
+ *
+ * The datagrams are sent in order, so that the remaining ones can be sent by sendFallback().
+ * @param socket The socket to send with
+ * @return The number of datagrams that were sent
+ */
+size_t DatagramBatch::sendNative(QUdpSocket &socket) {
+	const int fd = socket.socketDescriptor();
+	sockaddr_storage local;
+	socklen_t localLength = sizeof(local);
+	if (fd < 0 || datagrams.empty() || getsockname(fd, reinterpret_cast<sockaddr *>(&local), &localLength)) {
+		return 0;
+	}
+	headers.resize(datagrams.size());
+	payloads.resize(2 * datagrams.size());
+	receivers.resize(datagrams.size());
+	size_t count = 0;
+	for (auto &d : datagrams) {
+		socklen_t length;
+		// a receiver that this socket cannot reach ends the batch, Qt reports the error for it
+		if (!toSockaddr(d.address, local.ss_family, receivers[count], length)) {
+			break;
+		}
+		payloads[2 * count] = {const_cast<char *>(d.data.constData()), static_cast<size_t>(d.data.size())};
+		payloads[2 * count + 1] = {const_cast<char *>(d.tail.constData()), static_cast<size_t>(d.tail.size())};
+		headers[count] = {};
+		headers[count].msg_hdr.msg_name = &receivers[count];
+		headers[count].msg_hdr.msg_namelen = length;
+		headers[count].msg_hdr.msg_iov = &payloads[2 * count];
+		headers[count].msg_hdr.msg_iovlen = d.tail.isEmpty() ? 1 : 2;
+		++count;
+	}
+	size_t sent = 0;
+	while (sent < count) {
+		const int result = sendmmsg(fd, headers.data() + sent, static_cast<unsigned int>(count - sent), 0);
+		if (result < 0 && errno == EINTR) {
+			continue;
+		} else if (result <= 0) {
+			// Qt deals with the failing datagram
+			break;
+		}
+		sent += result;
+	}
+	return sent;
+}
+#else
+/**
+ * @brief Does nothing, there is no batched send path on this platform
+ * @return Always \c 0, so that every datagram is sent by sendFallback()
+ */
+size_t DatagramBatch::sendNative(QUdpSocket &) {
+	return 0;
+}
+#endif
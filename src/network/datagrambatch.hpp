@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QByteArray>
+#include <QUdpSocket>
+#include <vector>
+
+#ifdef Q_OS_LINUX
+#include <sys/socket.h>
+#endif
+
+#include "network.hpp"
+
+/**
+ * @brief Collects datagrams to several addresses and sends all of them at once
+ *
+ * On Linux the whole batch is handed to the kernel with a single sendmmsg() call, instead of one system call for every datagram.
+ * Everywhere else, or if that fails, every datagram is sent with QUdpSocket::writeDatagram() instead.
+ * A datagram may consist of a part shared with other datagrams and a part of its own, which are only joined if the fallback is used.
+ */
+class DatagramBatch {
+public:
+	void add(QByteArray datagram, const FullNetworkAddress &address);
+	void add(QByteArray head, QByteArray tail, const FullNetworkAddress &address);
+	void send(QUdpSocket &socket);
+private:
+	void sendFallback(QUdpSocket &socket, const size_t first);
+	size_t sendNative(QUdpSocket &socket);
+
+	/**
+	 * @brief A datagram waiting to be sent
+	 */
+	struct Datagram {
+		/**
+		 * @brief The payload, usually implicitly shared with the datagrams to other Clients
+		 */
+		QByteArray data;
+		/**
+		 * @brief The rest of the payload following DatagramBatch::Datagram::data, which may be empty
+		 */
+		QByteArray tail;
+		/**
+		 * @brief The receiver
+		 */
+		FullNetworkAddress address;
+	};
+	/**
+	 * @brief The datagrams that were not sent yet
+	 */
+	std::vector<Datagram> datagrams;
+#ifdef Q_OS_LINUX
+	/**
+	 * @brief The message headers passed to sendmmsg(), kept to avoid allocating them for every batch
+	 */
+	std::vector<mmsghdr> headers;
+	/**
+	 * @brief The two parts of the payload of every message
+	 */
+	std::vector<iovec> payloads;
+	/**
+	 * @brief The receiver of every message
+	 */
+	std::vector<sockaddr_storage> receivers;
+#endif
+};
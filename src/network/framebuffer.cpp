@@ -0,0 +1,69 @@
+#include "framebuffer.hpp"
+
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+
+// the size of the length prefix of every frame
+#define FRAME_HEADER_SIZE 4
+// the largest frame that is accepted, a larger length means that the stream is out of sync
+#define FRAME_MAX_SIZE (1 << 20)
+
+/**
+ * @brief Reads all available bytes from a device
+ *
+ * Frames that were handed out by next() are discarded first, so they must not be used anymore.
+ * @param device The device to read from
+ */
+void FrameBuffer::append(QIODevice &device) {
+	// usually all frames were consumed, otherwise only the start of a partial frame has to be moved to the front
+	const qsizetype remaining = buffer.size() - head;
+	if (head > 0) {
+		std::memmove(buffer.data(), buffer.constData() + head, remaining);
+		head = 0;
+	}
+	const qint64 available = device.bytesAvailable();
+	buffer.resize(remaining + available);
+	const qint64 read = device.read(buffer.data() + remaining, available);
+	buffer.resize(remaining + std::max<qint64>(read, 0));
+}
+
+/**
+ * @brief Hands out the next complete frame
+ * @param frame Is set to the content of the frame without its length prefix.
+ * It refers to the memory of the buffer without copying it, so it is only valid until the next call to append() or clear().
+ * @return \c True, iif a complete frame was available
+ */
+bool FrameBuffer::next(QByteArray &frame) {
+	if (corrupt || buffer.size() - head < FRAME_HEADER_SIZE) {
+		return false;
+	}
+	const quint32 length = qFromBigEndian<quint32>(buffer.constData() + head);
+	if (length > FRAME_MAX_SIZE) {
+		corrupt = true;
+		return false;
+	}
+	if (buffer.size() - head - FRAME_HEADER_SIZE < length) {
+		return false;
+	}
+	frame = QByteArray::fromRawData(buffer.constData() + head + FRAME_HEADER_SIZE, length);
+	head += FRAME_HEADER_SIZE + length;
+	return true;
+}
+
+/**
+ * @brief Forgets all received bytes, e.g. when connecting to another Server
+ */
+void FrameBuffer::clear() {
+	buffer.clear();
+	head = 0;
+	corrupt = false;
+}
+
+/**
+ * @brief Returns whether the stream cannot be split into frames anymore
+ * @return \c True, iif a frame announced an invalid length
+ */
+bool FrameBuffer::isCorrupt() const {
+	return corrupt;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <QByteArray>
+#include <QIODevice>
+
+/**
+ * @brief Collects the bytes received on a TCP connection and splits them into length-prefixed frames
+ *
+ * Every packet sent via TCP is preceded by its length, see Packet::AbstractPacket::toFrame().
+ * Received bytes are appended to a single buffer, that is reused for the whole connection.
+ * Complete frames are handed out in place without copying them, and partial frames simply stay in the buffer until the rest arrives.
+ * So a large burst of packets is split in a single pass, and a packet that cannot be parsed can be skipped, because its end is known.
+ */
+class FrameBuffer {
+public:
+	void append(QIODevice &device);
+	bool next(QByteArray &frame);
+	void clear();
+	bool isCorrupt() const;
+private:
+	/**
+	 * @brief The received bytes, the frames before FrameBuffer::head were handed out already
+	 */
+	QByteArray buffer;
+	/**
+	 * @brief The offset of the first byte in FrameBuffer::buffer, that was not handed out yet
+	 */
+	qsizetype head = 0;
+	/**
+	 * @brief Whether a frame announced a length, that no valid packet can have
+	 *
+	 * The stream cannot be split any further then, so the connection should be closed.
+	 */
+	bool corrupt = false;
+};
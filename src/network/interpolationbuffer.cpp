@@ -0,0 +1,131 @@
+#include "interpolationbuffer.hpp"
+
+#include <algorithm>
+#include <ranges>
+
+#include "settings.hpp"
+
+// the maximum number of snapshots kept for playback
+#define INTERPOLATION_BUFFER_SIZE 64
+// the number of recent arrivals that the mapping from ticks to the local clock is based on
+#define INTERPOLATION_CLOCK_SAMPLES 32
+
+InterpolationBuffer::InterpolationBuffer() {
+	clock.start();
+}
+
+/**
+ * @brief Adds a received snapshot
+ *
+ * Snapshots that arrive after the playback already passed their tick are dropped, as are duplicates.
+ * @param snapshot The snapshot to add, with already dequantized positions
+ */
+void InterpolationBuffer::push(Snapshot snapshot) {
+	arrivals.emplace_back(snapshot.tick, clock.nsecsElapsed() / 1e6);
+	if (arrivals.size() > INTERPOLATION_CLOCK_SAMPLES) {
+		arrivals.pop_front();
+	}
+	if (snapshot.tick <= playedTick) {
+		return;
+	}
+	const auto it = std::ranges::lower_bound(snapshots, snapshot.tick, {}, &Snapshot::tick);
+	if (it != snapshots.end() && it->tick == snapshot.tick) {
+		return;
+	}
+	snapshots.insert(it, std::move(snapshot));
+	if (snapshots.size() > INTERPOLATION_BUFFER_SIZE) {
+		snapshots.pop_front();
+	}
+}
+
+/**
+ * @brief Removes all snapshots and forgets the clock mapping, e.g. when connecting to another Server
+ */
+void InterpolationBuffer::clear() {
+	snapshots.clear();
+	arrivals.clear();
+	playedTick = 0;
+	displayedTick = 0;
+}
+
+/**
+ * @brief Removes all snapshots before the given tick and never plays them back
+ *
+ * This is needed, when the round is reset at \a tick, so that the trails of the old round are not continued in the new one.
+ * @param tick The first tick to play back
+ */
+void InterpolationBuffer::restart(const quint64 tick) {
+	std::erase_if(snapshots, [=](const Snapshot &s) { return s.tick < tick; });
+	if (tick > playedTick) {
+		playedTick = tick - 1;
+	}
+}
+
+/**
+ * @brief Advances the playback to the current time
+ *
+ * Every snapshot that the playback passed is returned as is, so that no corner of a trail is cut, even if the frame rate is low.
+ * These are followed by a snapshot interpolated between the two snapshots surrounding the current playback time.
+ * @param out Is filled with the snapshots to display in that order
+ * @return \c True, iif there are received snapshots that were not played back yet
+ */
+bool InterpolationBuffer::advance(std::vector<Snapshot> &out) {
+	out.clear();
+	if (snapshots.empty()) {
+		return false;
+	}
+	// the clock mapping may move back a little, when the fastest arrival leaves the window, but the playback must not
+	const double delay = Settings::get()->getInterpolationDelay() * Settings::get()->getUpdatesPerSecond() / 1000.0;
+	const double now = std::max(serverTick() - delay, displayedTick);
+	displayedTick = now;
+	for (const auto &s : snapshots) {
+		if (s.tick > now) {
+			break;
+		}
+		if (s.tick > playedTick) {
+			out.push_back(s);
+			playedTick = s.tick;
+		}
+	}
+	// only the last played back snapshot is needed to interpolate from
+	std::erase_if(snapshots, [this](const Snapshot &s) { return s.tick < playedTick; });
+	if (snapshots.size() >= 2 && snapshots[0].tick == playedTick) {
+		const Snapshot &a = snapshots[0];
+		const Snapshot &b = snapshots[1];
+		const double t = (now - a.tick) / (b.tick - a.tick);
+		// the number of players might have changed in between
+		if (t > 0 && a.positions.size() == b.positions.size()) {
+			Snapshot &s = out.emplace_back();
+			s.tick = a.tick;
+			for (size_t i = 0; i < a.positions.size(); ++i) {
+				s.positions.push_back(a.positions[i] + t * (b.positions[i] - a.positions[i]));
+				// never draw into a gap, that starts or ends in between
+				s.changingSegment.push_back(a.changingSegment[i] || b.changingSegment[i]);
+			}
+		}
+	}
+	return snapshots.back().tick > playedTick;
+}
+
+/**
+ * @brief Estimates the tick of the snapshot that the Server is sending right now
+ *
+ * The snapshot with the least delay determines, how the ticks of the Server map to the local clock.
+ * @return The tick, which is fractional in between two ticks, or \c 0 if nothing was received yet
+ */
+double InterpolationBuffer::serverTick() const {
+	if (arrivals.empty()) {
+		return 0;
+	}
+	const double tickLength = 1000.0 / Settings::get()->getUpdatesPerSecond();
+	const double offset = std::ranges::min(arrivals | std::views::transform([=](const auto &a) { return a.second - a.first * tickLength; }));
+	return (clock.nsecsElapsed() / 1e6 - offset) / tickLength;
+}
+
+/**
+ * @brief Returns the tick of the snapshot that was played back last
+ * @return The tick, or \c 0 if nothing was played back yet
+ */
+quint64 InterpolationBuffer::playbackTick() const {
+	return playedTick;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include "snapshot.hpp"
+
+/**
+ * @brief A jitter buffer that plays back the Curver positions received from the Server with a constant delay
+ *
+ * Received snapshots are sorted by their tick, so reordered datagrams still end up in the right place.
+ * The ticks are mapped to the local clock by the fastest recently received snapshot, which removes the jitter of the network.
+ * Playback then runs Settings::getInterpolationDelay() behind that clock and interpolates between the two surrounding snapshots,
+ * so a lost or late snapshot just leaves a longer gap to interpolate over.
+ */
+class InterpolationBuffer {
+public:
+	explicit InterpolationBuffer();
+
+	void push(Snapshot snapshot);
+	void clear();
+	void restart(const quint64 tick);
+	bool advance(std::vector<Snapshot> &out);
+	double serverTick() const;
+	quint64 playbackTick() const;
+private:
+
+	/**
+	 * @brief The received snapshots that were not played back yet, sorted by tick
+	 *
+	 * The front is the last played back snapshot, as long as the playback did not reach the next one.
+	 */
+	std::deque<Snapshot> snapshots;
+	/**
+	 * @brief The tick and local arrival time in milliseconds of the most recently received snapshots
+	 */
+	std::deque<std::pair<quint64, double>> arrivals;
+	/**
+	 * @brief The tick of the last snapshot that was played back, or \c 0 if there was none yet
+	 */
+	quint64 playedTick = 0;
+	/**
+	 * @brief The most recently displayed, possibly fractional, tick
+	 */
+	double displayedTick = 0;
+	/**
+	 * @brief The local clock that arrival and playback times refer to
+	 */
+	QElapsedTimer clock;
+};
@@ -1,5 +1,11 @@
 #include "network.hpp"
 
+#include <QtEndian>
+#include <bit>
+
+// fixed-point resolution of transmitted positions in steps per pixel
+#define POSITION_RESOLUTION 16
+
 bool operator==(const FullNetworkAddress &l, const FullNetworkAddress &r) {
 	return l.addr == r.addr && l.port == r.port;
 }
@@ -22,16 +28,7 @@ Packet::AbstractPacket::~AbstractPacket() {
  * @param s The socket to send with
  */
 void Packet::AbstractPacket::sendPacket(QTcpSocket *s) const {
-	QByteArray block;
-	QDataStream out(&block, QIODevice::WriteOnly);
-	// write type and flags to stream
-	uint8_t header = 0;
-	header |= type << (8 - PACKET_TYPE_BITS);
-	Util::setBit(header, 0, start);
-	Util::setBit(header, 1, reset);
-	out << header;
-	this->serialize(out);
-	s->write(block);
+	s->write(toFrame());
 }
 
 /**
@@ -40,8 +37,43 @@ void Packet::AbstractPacket::sendPacket(QTcpSocket *s) const {
  * @param a The address to send to
  */
 void Packet::AbstractPacket::sendPacketUdp(QUdpSocket *s, FullNetworkAddress a) const {
+	s->writeDatagram(toByteArray(), a.addr, a.port);
+}
+
+/**
+ * @brief Serializes the packet including its header
+ *
+ * This is the exact data that is sent over the network.
+ * @return The serialized packet
+ */
+QByteArray Packet::AbstractPacket::toByteArray() const {
+	QByteArray block;
+	QDataStream out(&block, QIODevice::WriteOnly);
+	serializeWithHeader(out);
+	return block;
+}
+
+/**
+ * @brief Serializes the packet including its header into a frame for TCP
+ *
+ * The packet is preceded by its length, so that the receiver can tell the packets in the stream apart, see FrameBuffer.
+ * @return The frame
+ */
+QByteArray Packet::AbstractPacket::toFrame() const {
 	QByteArray block;
 	QDataStream out(&block, QIODevice::WriteOnly);
+	// the length is not known yet, it is filled in afterwards
+	out << static_cast<quint32>(0);
+	serializeWithHeader(out);
+	qToBigEndian<quint32>(block.size() - sizeof(quint32), block.data());
+	return block;
+}
+
+/**
+ * @brief Serializes the header followed by the packet
+ * @param out The stream to serialize into
+ */
+void Packet::AbstractPacket::serializeWithHeader(QDataStream &out) const {
 	// write type and flags to stream
 	uint8_t header = 0;
 	header |= type << (8 - PACKET_TYPE_BITS);
@@ -49,7 +81,6 @@ void Packet::AbstractPacket::sendPacketUdp(QUdpSocket *s, FullNetworkAddress a)
 	Util::setBit(header, 1, reset);
 	out << header;
 	this->serialize(out);
-	s->writeDatagram(block, a.addr, a.port);
 }
 
 /**
@@ -58,66 +89,22 @@ void Packet::AbstractPacket::sendPacketUdp(QUdpSocket *s, FullNetworkAddress a)
  * The packet type is automatically deducted.
  * @param in The data stream to parse a packet from
  * @param from Whether the sender was a Server or Client instance
- * @return The received packet. If parsing was not successful, the smart pointer holds a nullptr
+ * @param pool The pool to parse the packet into
+ * @return The received packet, which lives in \a pool. If the packet type is unknown, this is a nullptr
  */
-std::unique_ptr<Packet::AbstractPacket> Packet::AbstractPacket::receivePacket(QDataStream &in, InstanceType from) {
-	std::unique_ptr<Packet::AbstractPacket> result;
+Packet::AbstractPacket *Packet::AbstractPacket::receivePacket(QDataStream &in, InstanceType from, PacketPool &pool) {
 	uint8_t header;
 	in >> header;
 	PacketType type = header >> (8 - PACKET_TYPE_BITS);
 	uint8_t flags = header << PACKET_TYPE_BITS >> PACKET_TYPE_BITS;
-	switch (from) {
-	case InstanceType::Server:
-		switch (static_cast<ServerTypes>(type)) {
-		case ServerTypes::Chat_Message:
-			result = std::make_unique<ServerChatMsg>();
-			break;
-		case ServerTypes::PlayerModelEdit:
-			result = std::make_unique<ServerPlayerModel>();
-			break;
-		case ServerTypes::CurverData:
-			result = std::make_unique<ServerCurverData>();
-			break;
-		case ServerTypes::ItemData:
-			result = std::make_unique<ServerItemData>();
-			break;
-		case ServerTypes::SettingsType:
-			result = std::make_unique<ServerSettingsData>();
-			break;
-		case ServerTypes::Pong:
-			result = std::make_unique<Pong>();
-			break;
-		default:
-			qDebug() << "unsupported server packet";
-			in.rollbackTransaction();
-		}
-		break;
-	case InstanceType::Client:
-		switch (static_cast<ClientTypes>(type)) {
-		case ClientTypes::Chat_Message:
-			result = std::make_unique<ClientChatMsg>();
-			break;
-		case ClientTypes::PlayerModelEdit:
-			result = std::make_unique<ClientPlayerModel>();
-			break;
-		case ClientTypes::CurverRotation:
-			result = std::make_unique<ClientCurverRotation>();
-			break;
-		case ClientTypes::Ping:
-			result = std::make_unique<Ping>();
-			break;
-		default:
-			qDebug() << "unsupported client packet";
-			in.rollbackTransaction();
-		}
-		break;
-	}
+	AbstractPacket *result = pool.get(from, type);
 	if (result) {
 		result->start = Util::getBit(flags, 0);
 		result->reset = Util::getBit(flags, 1);
 		result->parse(in);
 	} else {
 		qDebug() << "Received ill-formed packet";
+		in.setStatus(QDataStream::ReadCorruptData);
 	}
 	return result;
 }
@@ -204,22 +191,14 @@ Packet::ServerPlayerModel::ServerPlayerModel()
  * @brief Automatically fills the packet with the according data
  */
 void Packet::ServerPlayerModel::fill() {
-	QByteArray buf;
-	QDataStream pipe(&buf, QIODevice::WriteOnly);
-	PlayerModel::get()->serialize(pipe);
-	QDataStream in(&buf, QIODevice::ReadOnly);
-	this->parse(in);
+	PlayerModel::get()->serialize(data);
 }
 
 /**
  * @brief Automatically extracts the packet data
  */
 void Packet::ServerPlayerModel::extract() {
-	QByteArray buf;
-	QDataStream pipe(&buf, QIODevice::WriteOnly);
-	this->serialize(pipe);
-	QDataStream in(&buf, QIODevice::ReadOnly);
-	PlayerModel::get()->parse(in);
+	PlayerModel::get()->parse(data);
 }
 
 /**
@@ -261,6 +240,54 @@ void Packet::ClientPlayerModel::parse(QDataStream &in) {
 	in >> username >> color;
 }
 
+/**
+ * @brief Constructs a CurverFrame from the state of a simulation tick
+ * @param snapshot The state of the simulation
+ */
+Packet::CurverFrame::CurverFrame(const Snapshot &snapshot)
+	: tick(snapshot.tick) {
+	pos.reserve(snapshot.positions.size());
+	std::ranges::transform(snapshot.positions, std::back_inserter(pos), quantize);
+}
+
+/**
+ * @brief Constructs a CurverFrame
+ * @param tick The tick of the simulation
+ * @param pos The quantized positions
+ */
+Packet::CurverFrame::CurverFrame(const quint64 tick, std::vector<QPoint> pos)
+	: tick(tick), pos(std::move(pos)) {
+}
+
+/**
+ * @brief Converts a position to the fixed-point representation used on the network
+ * @param p The position in pixels
+ * @return The position in steps of 1/POSITION_RESOLUTION pixels
+ */
+QPoint Packet::quantize(const QPointF p) {
+	return QPoint(qRound(p.x() * POSITION_RESOLUTION), qRound(p.y() * POSITION_RESOLUTION));
+}
+
+/**
+ * @brief Converts a position from the fixed-point representation used on the network
+ * @param p The position in steps of 1/POSITION_RESOLUTION pixels
+ * @return The position in pixels
+ */
+QPointF Packet::dequantize(const QPoint p) {
+	return QPointF(p) / POSITION_RESOLUTION;
+}
+
+/**
+ * @brief Looks up a frame by its tick
+ * @param history The frames to search, ordered by tick
+ * @param tick The tick to look for
+ * @return The frame or \c nullptr, if \a history does not contain it
+ */
+const Packet::CurverFrame *Packet::findFrame(const std::deque<CurverFrame> &history, const quint64 tick) {
+	const auto it = std::ranges::lower_bound(history, tick, {}, &CurverFrame::tick);
+	return it != history.end() && it->tick == tick ? &*it : nullptr;
+}
+
 /**
  * @brief Constructs a ServerCurverData
  */
@@ -269,50 +296,141 @@ Packet::ServerCurverData::ServerCurverData()
 }
 
 /**
- * @brief Automatically fills the packet with the according data
- */
-void Packet::ServerCurverData::fill() {
-	auto &curvers = PlayerModel::get()->getCurvers();
-	pos.resize(curvers.size());
-	changingSegment.resize(curvers.size());
-	for (uint i = 0; i < curvers.size(); ++i) {
-		pos[i] = curvers[i]->getPos();
-		changingSegment[i] = curvers[i]->isChangingSegment();
+ * @brief Fills the packet with a frame
+ *
+ * If \a base is given and describes the same number of curvers, only the deltas against it are stored.
+ * @param frame The frame to send
+ * @param changingSegment Whether each Curver is changing segments
+ * @param base The latest frame that the receiver acknowledged, or \c nullptr
+ */
+void Packet::ServerCurverData::fill(const CurverFrame &frame, const std::vector<bool> &changingSegment, const CurverFrame *base) {
+	tick = frame.tick;
+	pos = frame.pos;
+	this->changingSegment = changingSegment;
+	baseTick = 0;
+	if (base && base->tick && base->pos.size() == pos.size()) {
+		baseTick = base->tick;
+		for (size_t i = 0; i < pos.size(); ++i) {
+			pos[i] -= base->pos[i];
+		}
 	}
 }
 
 /**
- * @brief Automatically extracts the packet data
+ * @brief Adds the motion of the Curver of the receiving Client, so that it can predict its own Curver
+ * @param snapshot The snapshot that the packet was filled with
+ * @param curverIndex The index of the Curver of the receiving Client, or \c -1 if it has none
  */
-void Packet::ServerCurverData::extract() {
-	auto &curvers = PlayerModel::get()->getCurvers();
-	if (curvers.size() != pos.size()) {
-		// invalid size, can be UDP related
+void Packet::ServerCurverData::fillPrediction(const Snapshot &snapshot, const int curverIndex) {
+	if (curverIndex < 0 || static_cast<size_t>(curverIndex) >= snapshot.motions.size() || snapshot.motions.size() != snapshot.positions.size()) {
+		this->curverIndex = -1;
 		return;
 	}
-	for (uint i = 0; i < curvers.size(); ++i) {
-		curvers[i]->appendPoint(pos[i], changingSegment[i]);
+	this->curverIndex = curverIndex;
+	inputSequence = snapshot.inputSequences[curverIndex];
+	motion = snapshot.motions[curverIndex];
+}
+
+/**
+ * @brief Serializes only the motion of the Curver of the receiving Client
+ *
+ * This allows serializing the part that is the same for many Clients only once.
+ * The prediction is the last field of the packet, and without a motion it is a single byte.
+ * A packet serialized by toByteArray() without a motion and without that last byte, followed by \a buffer, is the whole packet.
+ * @param buffer Is overwritten with the serialized prediction, keeping its capacity, so that a reused buffer does not allocate
+ */
+void Packet::ServerCurverData::writePrediction(QByteArray &buffer) const {
+	buffer.resize(0);
+	QDataStream out(&buffer, QIODevice::WriteOnly);
+	serializePrediction(out);
+}
+
+/**
+ * @brief Turns the received deltas back into absolute positions
+ * @param history The frames that were received before
+ * @return \c True, iif the positions are absolute now. Otherwise the frame that the deltas refer to is unknown.
+ *
+ * This also completes the position in ServerCurverData::motion.
+ */
+bool Packet::ServerCurverData::resolve(const std::deque<CurverFrame> &history) {
+	if (baseTick) {
+		const CurverFrame *base = findFrame(history, baseTick);
+		if (!base || base->pos.size() != pos.size()) {
+			return false;
+		}
+		for (size_t i = 0; i < pos.size(); ++i) {
+			pos[i] += base->pos[i];
+		}
+		baseTick = 0;
+	}
+	if (curverIndex >= 0) {
+		motion.pos = dequantize(pos[curverIndex]);
 	}
+	return true;
+}
+
+/**
+ * @brief Returns the frame described by this packet
+ *
+ * Only valid after resolve() succeeded.
+ * @return The frame
+ */
+Packet::CurverFrame Packet::ServerCurverData::frame() const {
+	return CurverFrame(tick, pos);
+}
+
+/**
+ * @brief Automatically extracts the packet data into the buffer that plays it back
+ *
+ * Only valid after resolve() succeeded.
+ * @param buffer The buffer to extract into
+ */
+void Packet::ServerCurverData::extract(InterpolationBuffer &buffer) const {
+	Snapshot snapshot;
+	snapshot.tick = tick;
+	std::ranges::transform(pos, std::back_inserter(snapshot.positions), dequantize);
+	snapshot.changingSegment = changingSegment;
+	buffer.push(std::move(snapshot));
 }
 
 /**
  * @brief Serializes the ServerCurverData
+ *
+ * All integers are variable-length encoded, see Util::serializeVarint(), so small deltas only take a single byte.
  * @param out The stream to serialize into
  */
 void Packet::ServerCurverData::serialize(QDataStream &out) const {
-	Util::serializeCnt(out, pos);
-	// the following procedure serializes every changingSegment into a single byte
-	uint8_t compressedByte = 0;
-	int lastPos = 8;
-	for (auto seg : changingSegment) {
-		if (lastPos == 0) {
-			out << compressedByte;
-			compressedByte = 0;
-			lastPos = 8;
+	Util::serializeVarint(out, tick);
+	// the base is sent as distance to the tick, which is much smaller
+	Util::serializeVarint(out, baseTick ? tick - baseTick : 0);
+	Util::serializeVarint(out, pos.size());
+	// the following procedure serializes every 8 changingSegment flags into a single byte
+	for (size_t i = 0; i < changingSegment.size(); i += 8) {
+		uint8_t compressedByte = 0;
+		for (size_t j = i; j < std::min(i + 8, changingSegment.size()); ++j) {
+			compressedByte |= changingSegment[j] << (7 - (j - i));
 		}
-		compressedByte |= seg << --lastPos;
+		out << compressedByte;
+	}
+	for (const auto &p : pos) {
+		Util::serializeZigzag(out, p.x());
+		Util::serializeZigzag(out, p.y());
+	}
+	serializePrediction(out);
+}
+
+/**
+ * @brief Serializes the motion of the Curver of the receiving Client, which is the last field of the packet
+ * @param out The stream to serialize into
+ */
+void Packet::ServerCurverData::serializePrediction(QDataStream &out) const {
+	Util::serializeVarint(out, curverIndex + 1);
+	if (curverIndex >= 0) {
+		Util::serializeVarint(out, inputSequence);
+		// floats are sent as they are, QDataStream would expand them to doubles
+		out << std::bit_cast<quint32>(motion.angle) << std::bit_cast<quint32>(motion.velocity) << std::bit_cast<quint32>(motion.rotateVelocity);
+		out << static_cast<uint8_t>(motion.rotation);
 	}
-	out << compressedByte;
 }
 
 /**
@@ -320,20 +438,70 @@ void Packet::ServerCurverData::serialize(QDataStream &out) const {
  * @param in The stream to parse from
  */
 void Packet::ServerCurverData::parse(QDataStream &in) {
-	Util::parseCnt(in, pos);
+	tick = Util::parseVarint(in);
+	const quint64 baseDistance = Util::parseVarint(in);
+	baseTick = baseDistance && baseDistance < tick ? tick - baseDistance : 0;
+	const quint64 size = Util::parseVarint(in);
+	// every Curver takes at least two bytes, anything else is corrupt and must not be allocated
+	if (in.status() != QDataStream::Ok || (baseDistance && !baseTick) || size > static_cast<quint64>(in.device()->bytesAvailable()) / 2) {
+		in.setStatus(QDataStream::ReadCorruptData);
+		return;
+	}
 	// the following procedure parses every changingSegment bit by bit
-	changingSegment.resize(pos.size());
-	uint8_t compressedByte;
-	int lastPos = 0;
-	for (auto seg : changingSegment) {
-		if (lastPos == 0) {
-			in >> compressedByte;
-			lastPos = 8;
+	changingSegment.resize(size);
+	for (size_t i = 0; i < size; i += 8) {
+		uint8_t compressedByte = 0;
+		in >> compressedByte;
+		for (size_t j = i; j < std::min(i + 8, static_cast<size_t>(size)); ++j) {
+			changingSegment[j] = Util::getBit(compressedByte, 7 - (j - i));
 		}
-		seg = Util::getBit(compressedByte, --lastPos);
+	}
+	pos.resize(size);
+	for (auto &p : pos) {
+		const qint64 x = Util::parseZigzag(in);
+		p = QPoint(x, Util::parseZigzag(in));
+	}
+	const quint64 index = Util::parseVarint(in);
+	if (index > size) {
+		in.setStatus(QDataStream::ReadCorruptData);
+		return;
+	}
+	curverIndex = static_cast<int>(index) - 1;
+	if (curverIndex >= 0) {
+		inputSequence = Util::parseVarint(in);
+		quint32 angle, velocity, rotateVelocity;
+		uint8_t rotation;
+		in >> angle >> velocity >> rotateVelocity >> rotation;
+		motion.angle = std::bit_cast<float>(angle);
+		motion.velocity = std::bit_cast<float>(velocity);
+		motion.rotateVelocity = std::bit_cast<float>(rotateVelocity);
+		motion.rotation = static_cast<Curver::Rotation>(rotation);
 	}
 }
 
+/**
+ * @brief Constructs a SnapshotAck
+ */
+Packet::SnapshotAck::SnapshotAck()
+	: AbstractPacket(static_cast<PacketType>(ClientTypes::SnapshotAck)) {
+}
+
+/**
+ * @brief Serializes the SnapshotAck
+ * @param out The stream to serialize into
+ */
+void Packet::SnapshotAck::serialize(QDataStream &out) const {
+	Util::serializeVarint(out, tick);
+}
+
+/**
+ * @brief Parses a SnapshotAck
+ * @param in The stream to parse from
+ */
+void Packet::SnapshotAck::parse(QDataStream &in) {
+	tick = Util::parseVarint(in);
+}
+
 /**
  * @brief Constructs a ClientCurverRotation
  */
@@ -346,7 +514,11 @@ Packet::ClientCurverRotation::ClientCurverRotation()
  * @param out The stream to serialize into
  */
 void Packet::ClientCurverRotation::serialize(QDataStream &out) const {
-	out << static_cast<uint8_t>(rotation);
+	Util::serializeVarint(out, sequence);
+	Util::serializeVarint(out, rotations.size());
+	for (const auto r : rotations) {
+		out << static_cast<uint8_t>(r);
+	}
 }
 
 /**
@@ -354,9 +526,19 @@ void Packet::ClientCurverRotation::serialize(QDataStream &out) const {
  * @param in The stream to parse from
  */
 void Packet::ClientCurverRotation::parse(QDataStream &in) {
-	uint8_t rot;
-	in >> rot;
-	rotation = static_cast<Curver::Rotation>(rot);
+	sequence = Util::parseVarint(in);
+	const quint64 size = Util::parseVarint(in);
+	// every rotation takes a byte, anything else is corrupt and must not be allocated
+	if (in.status() != QDataStream::Ok || size > static_cast<quint64>(in.device()->bytesAvailable())) {
+		in.setStatus(QDataStream::ReadCorruptData);
+		return;
+	}
+	rotations.resize(size);
+	for (auto &r : rotations) {
+		uint8_t rot;
+		in >> rot;
+		r = static_cast<Curver::Rotation>(rot);
+	}
 }
 
 /**
@@ -396,7 +578,7 @@ Packet::Ping::Ping()
  * @param out The stream to serialize into
  */
 void Packet::Ping::serialize(QDataStream &out) const {
-	out << sent << delta;
+	out << sent << delta << playerId;
 }
 
 /**
@@ -404,7 +586,7 @@ void Packet::Ping::serialize(QDataStream &out) const {
  * @param in The stream to parse from
  */
 void Packet::Ping::parse(QDataStream &in) {
-	in >> sent >> delta;
+	in >> sent >> delta >> playerId;
 }
 
 /**
@@ -419,6 +601,7 @@ Packet::ServerSettingsData::ServerSettingsData()
  */
 void Packet::ServerSettingsData::fill() {
 	this->dimension = Settings::get()->getDimension();
+	this->updatesPerSecond = Settings::get()->getUpdatesPerSecond();
 }
 
 /**
@@ -426,6 +609,7 @@ void Packet::ServerSettingsData::fill() {
  */
 void Packet::ServerSettingsData::extract() {
 	Settings::get()->setDimension(this->dimension);
+	Settings::get()->setUpdatesPerSecond(this->updatesPerSecond);
 }
 
 /**
@@ -433,7 +617,7 @@ void Packet::ServerSettingsData::extract() {
  * @param out The stream to serialize into
  */
 void Packet::ServerSettingsData::serialize(QDataStream &out) const {
-	out << dimension;
+	out << dimension << updatesPerSecond;
 }
 
 /**
@@ -441,7 +625,7 @@ void Packet::ServerSettingsData::serialize(QDataStream &out) const {
  * @param in The stream to parse from
  */
 void Packet::ServerSettingsData::parse(QDataStream &in) {
-	in >> dimension;
+	in >> dimension >> updatesPerSecond;
 }
 
 /**
@@ -493,8 +677,105 @@ void Packet::Pong::parse(QDataStream &in) {
 	qint64 ping;
 
 	in >> sent >> curverIndex >> size;
+	pings.clear();
 	for (auto i = 0; i < size; ++i) {
 		in >> ping;
 		pings.push_back(ping);
 	}
 }
+
+/**
+ * @brief Constructs a ServerWelcome
+ */
+Packet::ServerWelcome::ServerWelcome()
+	: AbstractPacket(static_cast<PacketType>(ServerTypes::Welcome)) {
+}
+
+/**
+ * @brief Serializes the ServerWelcome
+ * @param out The stream to serialize into
+ */
+void Packet::ServerWelcome::serialize(QDataStream &out) const {
+	out << playerId;
+}
+
+/**
+ * @brief Parses a ServerWelcome
+ * @param in The stream to parse from
+ */
+void Packet::ServerWelcome::parse(QDataStream &in) {
+	in >> playerId;
+}
+
+/**
+ * @brief Constructs a ServerRedirect
+ */
+Packet::ServerRedirect::ServerRedirect()
+	: AbstractPacket(static_cast<PacketType>(ServerTypes::Redirect)) {
+}
+
+/**
+ * @brief Serializes the ServerRedirect
+ * @param out The stream to serialize into
+ */
+void Packet::ServerRedirect::serialize(QDataStream &out) const {
+	out << port;
+}
+
+/**
+ * @brief Parses a ServerRedirect
+ * @param in The stream to parse from
+ */
+void Packet::ServerRedirect::parse(QDataStream &in) {
+	in >> port;
+}
+
+/**
+ * @brief Returns the instance of a packet type
+ * @param from Whether the sender is a Server or Client instance
+ * @param type The type of the packet
+ * @return The packet instance, or \c nullptr if there is no such packet type
+ */
+Packet::AbstractPacket *Packet::PacketPool::get(const InstanceType from, const PacketType type) {
+	switch (from) {
+	case InstanceType::Server:
+		switch (static_cast<ServerTypes>(type)) {
+		case ServerTypes::Chat_Message:
+			return &serverChatMsg;
+		case ServerTypes::PlayerModelEdit:
+			return &serverPlayerModel;
+		case ServerTypes::CurverData:
+			return &serverCurverData;
+		case ServerTypes::ItemData:
+			return &serverItemData;
+		case ServerTypes::SettingsType:
+			return &serverSettingsData;
+		case ServerTypes::Pong:
+			return &pong;
+		case ServerTypes::Welcome:
+			return &serverWelcome;
+		case ServerTypes::Redirect:
+			return &serverRedirect;
+		default:
+			qDebug() << "unsupported server packet";
+			return nullptr;
+		}
+	case InstanceType::Client:
+		switch (static_cast<ClientTypes>(type)) {
+		case ClientTypes::Chat_Message:
+			return &clientChatMsg;
+		case ClientTypes::PlayerModelEdit:
+			return &clientPlayerModel;
+		case ClientTypes::CurverRotation:
+			return &clientCurverRotation;
+		case ClientTypes::Ping:
+			return &ping;
+		case ClientTypes::SnapshotAck:
+			return &snapshotAck;
+		default:
+			qDebug() << "unsupported client packet";
+			return nullptr;
+		}
+	}
+	return nullptr;
+}
@@ -2,12 +2,15 @@
 
 #include <QString>
 #include <QtNetwork>
+#include <deque>
 
 #include "curver.hpp"
 #include "gui.hpp"
+#include "interpolationbuffer.hpp"
 #include "items/item.hpp"
 #include "models/chatmodel.hpp"
 #include "models/playermodel.hpp"
+#include "snapshot.hpp"
 #include "util.hpp"
 
 /**
@@ -26,6 +29,16 @@ struct FullNetworkAddress {
 
 bool operator==(const FullNetworkAddress &l, const FullNetworkAddress &r);
 
+/**
+ * @brief Hashes a FullNetworkAddress including its port, so it can be used as key of hash maps
+ */
+template <>
+struct std::hash<FullNetworkAddress> {
+	size_t operator()(const FullNetworkAddress &a) const noexcept {
+		return qHashMulti(0, a.addr, a.port);
+	}
+};
+
 /**
  * @brief An enumeration representing the instance type.
  *
@@ -57,6 +70,8 @@ enum class ServerTypes : PacketType {
 	ItemData,
 	SettingsType,
 	Pong,
+	Welcome,
+	Redirect,
 };
 
 /**
@@ -67,8 +82,11 @@ enum class ClientTypes : PacketType {
 	PlayerModelEdit,
 	CurverRotation,
 	Ping,
+	SnapshotAck,
 };
 
+class PacketPool;
+
 /**
  * @brief A class representing an abstract packet.
  *
@@ -80,7 +98,9 @@ public:
 	virtual ~AbstractPacket();
 	void sendPacket(QTcpSocket *s) const;
 	void sendPacketUdp(QUdpSocket *s, FullNetworkAddress a) const;
-	static std::unique_ptr<AbstractPacket> receivePacket(QDataStream &in, InstanceType from);
+	QByteArray toByteArray() const;
+	QByteArray toFrame() const;
+	static AbstractPacket *receivePacket(QDataStream &in, InstanceType from, PacketPool &pool);
 	/**
 	 * @brief The packet type
 	 */
@@ -94,6 +114,7 @@ public:
 	 */
 	bool reset = false;
 protected:
+	void serializeWithHeader(QDataStream &out) const;
 	/**
 	 * @brief Serializes a packet
 	 * @param out The stream to serialize into
@@ -209,37 +230,116 @@ protected:
 	virtual void parse(QDataStream &in) override;
 };
 
+/**
+ * @brief The positions of all curvers after a simulation tick in fixed-point representation
+ *
+ * This is the state that ServerCurverData packets are delta encoded against.
+ */
+struct CurverFrame {
+	explicit CurverFrame(const Snapshot &snapshot);
+	explicit CurverFrame(const quint64 tick = 0, std::vector<QPoint> pos = {});
+	/**
+	 * @brief The tick of the simulation
+	 */
+	quint64 tick;
+	/**
+	 * @brief The quantized position of every Curver, see quantize()
+	 */
+	std::vector<QPoint> pos;
+};
+
+QPoint quantize(const QPointF p);
+QPointF dequantize(const QPoint p);
+const CurverFrame *findFrame(const std::deque<CurverFrame> &history, const quint64 tick);
+
 /**
  * @brief A packet that represents a Curver data post from the Server
+ *
+ * The positions are either absolute, or deltas against an earlier frame that the Client acknowledged with a SnapshotAck.
  */
 class ServerCurverData : public AbstractPacket {
 public:
 	ServerCurverData();
-	void fill();
-	void extract();
+	void fill(const CurverFrame &frame, const std::vector<bool> &changingSegment, const CurverFrame *base = nullptr);
+	bool resolve(const std::deque<CurverFrame> &history);
+	void fillPrediction(const Snapshot &snapshot, const int curverIndex);
+	void writePrediction(QByteArray &buffer) const;
+	CurverFrame frame() const;
+	void extract(InterpolationBuffer &buffer) const;
+	/**
+	 * @brief The simulation tick that this packet describes
+	 */
+	quint64 tick = 0;
 	/**
-	 * @brief The new positions cumulated from every Curver
+	 * @brief The tick of the frame that ServerCurverData::pos is relative to, or \c 0 if the positions are absolute
 	 */
-	std::vector<QPointF> pos;
+	quint64 baseTick = 0;
+	/**
+	 * @brief The quantized positions of every Curver
+	 *
+	 * Until resolve() is called, these are deltas against the frame of ServerCurverData::baseTick.
+	 */
+	std::vector<QPoint> pos;
 	/**
 	 * @brief Whether an individual Curver is changing segments at the moment
 	 */
 	std::vector<bool> changingSegment;
+	/**
+	 * @brief The index of the Curver of the receiving Client, or \c -1 if the packet does not contain its motion
+	 */
+	int curverIndex = -1;
+	/**
+	 * @brief The sequence number of the last input of the receiving Client, that was applied at ServerCurverData::tick
+	 */
+	quint32 inputSequence = 0;
+	/**
+	 * @brief The motion of the Curver of the receiving Client
+	 *
+	 * The position is not transmitted, it is the one in ServerCurverData::pos.
+	 */
+	Curver::Motion motion;
 protected:
 	virtual void serialize(QDataStream &out) const override;
 	virtual void parse(QDataStream &in) override;
+private:
+	void serializePrediction(QDataStream &out) const;
 };
 
 /**
  * @brief A packet that represents a Curver rotation change coming from the Client
+ *
+ * It is sent via UDP and repeats the latest inputs, that the Server did not confirm yet, so a lost datagram does not lose an input.
  */
 class ClientCurverRotation : public AbstractPacket {
 public:
 	ClientCurverRotation();
 	/**
-	 * @brief The wanted rotation of the Curver
+	 * @brief The wanted rotations of the Curver, ordered from the oldest to the newest input
+	 */
+	std::vector<Curver::Rotation> rotations;
+	/**
+	 * @brief The sequence number of the newest input, the inputs before it have the preceding sequence numbers
+	 *
+	 * It is increasing with every input of the Client.
+	 */
+	quint32 sequence = 0;
+protected:
+	virtual void serialize(QDataStream &out) const override;
+	virtual void parse(QDataStream &in) override;
+};
+
+/**
+ * @brief A packet that acknowledges the newest ServerCurverData that a Client received
+ *
+ * The Server then encodes the following ServerCurverData packets relative to this frame.
+ */
+class SnapshotAck : public AbstractPacket {
+public:
+	SnapshotAck();
+	/**
+	 * @brief The tick of the acknowledged frame
 	 */
-	Curver::Rotation rotation;
+	quint64 tick = 0;
 protected:
 	virtual void serialize(QDataStream &out) const override;
 	virtual void parse(QDataStream &in) override;
@@ -299,6 +399,12 @@ public:
 	 * The ping delta is updated with every Pong received from the server.
 	 */
 	qint64 delta = 0;
+	/**
+	 * @brief The player id that the Client received with ServerWelcome, or \c 0 if there was none yet
+	 *
+	 * The Server uses it to tie the UDP address of the Client to its TCP connection.
+	 */
+	quint32 playerId = 0;
 protected:
 	virtual void serialize(QDataStream &out) const override;
 	virtual void parse(QDataStream &in) override;
@@ -316,6 +422,10 @@ public:
 	 * @brief The dimension of the game field
 	 */
 	QPoint dimension;
+	/**
+	 * @brief The number of simulation ticks per second, which tells the Client how long a tick takes
+	 */
+	quint32 updatesPerSecond;
 protected:
 	virtual void serialize(QDataStream &out) const override;
 	virtual void parse(QDataStream &in) override;
@@ -346,4 +456,99 @@ protected:
 	virtual void parse(QDataStream &in) override;
 };
 
+/**
+ * @brief A packet that tells a newly connected Client its player id over TCP
+ */
+class ServerWelcome : public AbstractPacket {
+public:
+	ServerWelcome();
+	/**
+	 * @brief The player id of the Client, see Ping::playerId
+	 */
+	quint32 playerId = 0;
+protected:
+	virtual void serialize(QDataStream &out) const override;
+	virtual void parse(QDataStream &in) override;
+};
+
+/**
+ * @brief A packet that sends a Client from a Lobby to the room that it joins over TCP
+ */
+class ServerRedirect : public AbstractPacket {
+public:
+	ServerRedirect();
+	/**
+	 * @brief The port of the room on the same host
+	 */
+	quint16 port = 0;
+protected:
+	virtual void serialize(QDataStream &out) const override;
+	virtual void parse(QDataStream &in) override;
+};
+
+/**
+ * @brief One reusable instance of every packet type that can be received
+ *
+ * Every receiver owns a pool and AbstractPacket::receivePacket() parses into the instance of the received type,
+ * so receiving does not allocate a new packet every time, and the containers inside of the packets keep their capacity.
+ * The returned packet is only valid until the next packet is received with the same pool.
+ */
+class PacketPool {
+public:
+	AbstractPacket *get(const InstanceType from, const PacketType type);
+private:
+	/**
+	 * @brief The chat messages received from a Server
+	 */
+	ServerChatMsg serverChatMsg;
+	/**
+	 * @brief The PlayerModel changes received from a Server
+	 */
+	ServerPlayerModel serverPlayerModel;
+	/**
+	 * @brief The Curver data received from a Server
+	 */
+	ServerCurverData serverCurverData;
+	/**
+	 * @brief The Item events received from a Server
+	 */
+	ServerItemData serverItemData;
+	/**
+	 * @brief The game settings received from a Server
+	 */
+	ServerSettingsData serverSettingsData;
+	/**
+	 * @brief The answers to Ping received from a Server
+	 */
+	Pong pong;
+	/**
+	 * @brief The player ids received from a Server
+	 */
+	ServerWelcome serverWelcome;
+	/**
+	 * @brief The redirects received from a Lobby
+	 */
+	ServerRedirect serverRedirect;
+	/**
+	 * @brief The chat messages received from a Client
+	 */
+	ClientChatMsg clientChatMsg;
+	/**
+	 * @brief The PlayerModel changes received from a Client
+	 */
+	ClientPlayerModel clientPlayerModel;
+	/**
+	 * @brief The Curver rotations received from a Client
+	 */
+	ClientCurverRotation clientCurverRotation;
+	/**
+	 * @brief The Pings received from a Client
+	 */
+	Ping ping;
+	/**
+	 * @brief The acknowledgements received from a Client
+	 */
+	SnapshotAck snapshotAck;
+};
+
 }
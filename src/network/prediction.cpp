@@ -0,0 +1,136 @@
+#include "prediction.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "settings.hpp"
+
+// the maximum number of ticks predicted ahead of the newest confirmation, so the Curver does not run away if the Server stops sending
+#define PREDICTION_MAX_TICKS 60
+// the maximum number of unconfirmed inputs, older ones are forgotten if the Server does not confirm anything
+#define PREDICTION_MAX_INPUTS 64
+
+/**
+ * @brief Records a new input
+ * @param rotation The rotation chosen by the input
+ * @param tick The tick at which the Server is expected to apply the input
+ * @return The sequence number of the input
+ */
+quint32 Prediction::input(const Curver::Rotation rotation, const double tick) {
+	inputs.push_back({nextSequence, rotation, tick});
+	if (inputs.size() > PREDICTION_MAX_INPUTS) {
+		inputs.pop_front();
+	}
+	return nextSequence++;
+}
+
+/**
+ * @brief Confirms the motion of the Curver at a tick
+ *
+ * Confirmations older than the newest one are ignored.
+ * @param tick The tick that the motion belongs to
+ * @param motion The motion of the Curver as simulated by the Server
+ * @param inputSequence The sequence number of the last input that the Server applied until \a tick
+ * @param changingSegment Whether the Curver was changing segments at \a tick
+ * @param curverIndex The index of the Curver
+ * @return \c True, iif this is the newest confirmation
+ */
+bool Prediction::confirm(const quint64 tick, const Curver::Motion &motion, const quint32 inputSequence, const bool changingSegment, const int curverIndex) {
+	if (tick <= confirmedTick) {
+		return false;
+	}
+	confirmedTick = tick;
+	confirmed = motion;
+	hasConfirmed = true;
+	this->curverIndex = curverIndex;
+	confirmedPath.emplace_back(motion.pos, changingSegment);
+	// the Server knows about these inputs already
+	while (!inputs.empty() && inputs.front().sequence <= inputSequence) {
+		inputs.pop_front();
+	}
+	return true;
+}
+
+/**
+ * @brief Forgets everything, e.g. when connecting to another Server
+ */
+void Prediction::clear() {
+	inputs.clear();
+	nextSequence = 1;
+	confirmedTick = 0;
+	hasConfirmed = false;
+	confirmedPath.clear();
+	curverIndex = -1;
+}
+
+/**
+ * @brief Stops predicting until a confirmation of the given tick or a newer one arrives
+ *
+ * This is needed, when the round is reset at \a tick, so that the Curver does not continue its path of the old round.
+ * @param tick The first tick of the new round
+ */
+void Prediction::restart(const quint64 tick) {
+	if (tick > confirmedTick) {
+		confirmedTick = tick - 1;
+	}
+	hasConfirmed = false;
+	confirmedPath.clear();
+}
+
+/**
+ * @brief Predicts the path of the Curver from the newest confirmed motion up to the given tick
+ * @param tick The tick to predict, which may be fractional
+ * @param path Is filled with the position after every tick, starting with the confirmed position. It stays empty, if there is nothing to predict from.
+ */
+void Prediction::predict(const double tick, std::vector<QPointF> &path) const {
+	path.clear();
+	if (!hasConfirmed) {
+		return;
+	}
+	const float tickLength = 1000.f / Settings::get()->getUpdatesPerSecond();
+	const double target = std::min(tick, static_cast<double>(confirmedTick + PREDICTION_MAX_TICKS));
+	Curver::Motion motion = confirmed;
+	path.push_back(motion.pos);
+	auto next = inputs.cbegin();
+	for (quint64 t = confirmedTick + 1; t <= target; ++t) {
+		// an input arriving in between two ticks takes effect in the following one
+		for (; next != inputs.cend() && next->tick <= t; ++next) {
+			motion.rotation = next->rotation;
+		}
+		motion.step(tickLength);
+		path.push_back(motion.pos);
+	}
+	// the rest of the time up to the fractional tick keeps the head moving smoothly
+	const double fraction = target - std::max(std::floor(target), static_cast<double>(confirmedTick));
+	if (fraction > 0) {
+		for (; next != inputs.cend() && next->tick <= target; ++next) {
+			motion.rotation = next->rotation;
+		}
+		motion.step(fraction * tickLength);
+		path.push_back(motion.pos);
+	}
+}
+
+/**
+ * @brief Returns the confirmed positions that were not displayed yet and forgets them
+ * @return The positions and whether the Curver was changing segments at each of them
+ */
+std::vector<std::pair<QPointF, bool>> Prediction::takeConfirmedPath() {
+	return std::exchange(confirmedPath, {});
+}
+
+/**
+ * @brief Returns the index of the predicted Curver
+ * @return The index or \c -1, if the Server did not tell it yet
+ */
+int Prediction::getCurverIndex() const {
+	return curverIndex;
+}
+
+/**
+ * @brief Returns the inputs that the Server did not confirm yet
+ * @return The inputs with consecutive sequence numbers, ordered from the oldest to the newest
+ */
+const std::deque<Prediction::Input> &Prediction::getInputs() const {
+	return inputs;
+}
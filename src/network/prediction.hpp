@@ -0,0 +1,76 @@
+#pragma once
+
+#include <QPointF>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include "curver.hpp"
+
+/**
+ * @brief Predicts the Curver of the Client, so that its inputs take effect without waiting for the Server
+ *
+ * Every input is tagged with a sequence number and the tick at which the Server is expected to apply it.
+ * The Server answers with the motion of the Curver at a tick and the sequence number of the last input it applied until then.
+ * The prediction always starts at the newest of these confirmed motions and replays all inputs that the Server did not apply yet,
+ * using the same movement code as the game logic, see Curver::Motion::step().
+ * So any misprediction is corrected as soon as the next confirmation arrives.
+ */
+class Prediction {
+public:
+	/**
+	 * @brief An input that the Server did not confirm yet
+	 */
+	struct Input {
+		/**
+		 * @brief The sequence number of the input
+		 */
+		quint32 sequence;
+		/**
+		 * @brief The rotation chosen by the input
+		 */
+		Curver::Rotation rotation;
+		/**
+		 * @brief The tick at which the Server is expected to apply the input
+		 */
+		double tick;
+	};
+
+	quint32 input(const Curver::Rotation rotation, const double tick);
+	bool confirm(const quint64 tick, const Curver::Motion &motion, const quint32 inputSequence, const bool changingSegment, const int curverIndex);
+	void clear();
+	void restart(const quint64 tick);
+	void predict(const double tick, std::vector<QPointF> &path) const;
+	std::vector<std::pair<QPointF, bool>> takeConfirmedPath();
+	int getCurverIndex() const;
+	const std::deque<Input> &getInputs() const;
+private:
+	/**
+	 * @brief All inputs that the Server did not confirm yet, ordered by sequence number
+	 */
+	std::deque<Input> inputs;
+	/**
+	 * @brief The sequence number of the next input, \c 0 is reserved for no input at all
+	 */
+	quint32 nextSequence = 1;
+	/**
+	 * @brief The tick of the newest confirmed motion
+	 */
+	quint64 confirmedTick = 0;
+	/**
+	 * @brief The newest confirmed motion
+	 */
+	Curver::Motion confirmed;
+	/**
+	 * @brief Whether Prediction::confirmed is valid for the current round
+	 */
+	bool hasConfirmed = false;
+	/**
+	 * @brief The confirmed positions and whether they were changing segments, which were not displayed yet
+	 */
+	std::vector<std::pair<QPointF, bool>> confirmedPath;
+	/**
+	 * @brief The index of the predicted Curver, or \c -1 if the Server did not tell it yet
+	 */
+	int curverIndex = -1;
+};
@@ -0,0 +1,114 @@
+#include "ratecontrol.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "settings.hpp"
+
+// the number of sent Curver data that the loss and bandwidth are estimated from
+#define RATE_HISTORY_SIZE 128
+// the largest interval in broadcasts, so that the playback of the Client does not run dry
+#define RATE_MAX_INTERVAL 6u
+// the time in milliseconds between two adjustments of the interval
+#define RATE_ADJUST_PERIOD 500
+// the time in milliseconds that an acknowledgement may take longer than the round trip time
+#define RATE_ACK_MARGIN 100
+// the minimum number of settled Curver data to estimate the loss from
+#define RATE_MIN_SAMPLES 8
+// above this loss the interval is doubled
+#define RATE_LOSS_HIGH 0.1
+// below this loss the interval is decreased again
+#define RATE_LOSS_LOW 0.02
+// the size of the IPv4 and UDP headers of every datagram
+#define RATE_DATAGRAM_OVERHEAD 28
+
+RateControl::RateControl() {
+	clock.start();
+}
+
+/**
+ * @brief Decides whether the Client gets the Curver data of the current broadcast
+ *
+ * This must be called exactly once for every broadcast.
+ * @return \c True, iif the Curver data should be sent to the Client
+ */
+bool RateControl::shouldSend() {
+	if (++skipped < interval) {
+		return false;
+	}
+	skipped = 0;
+	return true;
+}
+
+/**
+ * @brief Records Curver data that was sent to the Client
+ * @param tick The tick of the Curver data
+ * @param bytes The size of the datagram
+ */
+void RateControl::sent(const quint64 tick, const qsizetype bytes) {
+	const qint64 now = clock.elapsed();
+	history.push_back({tick, now, bytes + RATE_DATAGRAM_OVERHEAD});
+	if (history.size() > RATE_HISTORY_SIZE) {
+		history.pop_front();
+	}
+	if (now - lastAdjustment >= RATE_ADJUST_PERIOD) {
+		adjust();
+	}
+}
+
+/**
+ * @brief Records an acknowledgement of the Client
+ * @param tick The tick of the acknowledged Curver data
+ */
+void RateControl::acknowledged(const quint64 tick) {
+	const auto it = std::ranges::lower_bound(history, tick, {}, &Sent::tick);
+	if (it != history.end() && it->tick == tick) {
+		it->acknowledged = true;
+	}
+}
+
+/**
+ * @brief Sets the round trip time of the Client
+ *
+ * Curver data is only counted as lost, if it is not acknowledged within this time.
+ * @param rtt The round trip time in milliseconds, as measured by the Client with Packet::Ping
+ */
+void RateControl::setRoundTripTime(const qint64 rtt) {
+	roundTripTime = std::max<qint64>(rtt, 0);
+}
+
+/**
+ * @brief Adapts the interval to the loss and the bandwidth budget
+ *
+ * The loss is estimated from the Curver data, whose acknowledgement should have arrived by now.
+ * These are forgotten afterwards, so every change of the interval is judged by its own consequences only.
+ */
+void RateControl::adjust() {
+	const qint64 now = clock.elapsed();
+	lastAdjustment = now;
+	const qint64 settled = now - roundTripTime - RATE_ACK_MARGIN;
+	size_t count = 0;
+	size_t lost = 0;
+	qsizetype bytes = 0;
+	for (const auto &s : history) {
+		bytes += s.bytes;
+		if (s.time <= settled) {
+			++count;
+			lost += !s.acknowledged;
+		}
+	}
+	const double averageBytes = history.empty() ? 0 : static_cast<double>(bytes) / history.size();
+	if (count >= RATE_MIN_SAMPLES) {
+		const double loss = static_cast<double>(lost) / count;
+		if (loss > RATE_LOSS_HIGH) {
+			interval *= 2;
+		} else if (loss < RATE_LOSS_LOW && interval > 1) {
+			--interval;
+		}
+		std::erase_if(history, [=](const Sent &s) { return s.time <= settled; });
+	}
+	// the smallest interval, whose updates fit into the bandwidth of the Client
+	const double broadcastsPerSecond = static_cast<double>(Settings::get()->getUpdatesPerSecond()) / Settings::get()->getNetworkCurverBlock();
+	const unsigned budgetInterval = static_cast<unsigned>(std::ceil(averageBytes * broadcastsPerSecond / (std::max(Settings::get()->getNetworkBandwidth(), 1) * 1000.0)));
+	interval = std::clamp(std::max(interval, budgetInterval), 1u, RATE_MAX_INTERVAL);
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <deque>
+
+/**
+ * @brief Adapts the rate of Curver data sent to a single Client to its connection
+ *
+ * Every Client acknowledges the Curver data that it receives, see Packet::SnapshotAck.
+ * Curver data that is not acknowledged within the round trip time of the Client is counted as lost.
+ * The rate is halved whenever the loss is high, and slowly increased again while there is next to no loss,
+ * but it never exceeds the bandwidth that Settings::getNetworkBandwidth() grants every Client.
+ * So Clients on a good connection get every update, while congested Clients get fewer updates instead of a growing queue.
+ */
+class RateControl {
+public:
+	explicit RateControl();
+
+	bool shouldSend();
+	void sent(const quint64 tick, const qsizetype bytes);
+	void acknowledged(const quint64 tick);
+	void setRoundTripTime(const qint64 rtt);
+private:
+	void adjust();
+
+	/**
+	 * @brief Curver data that was sent to the Client
+	 */
+	struct Sent {
+		/**
+		 * @brief The tick of the Curver data
+		 */
+		quint64 tick;
+		/**
+		 * @brief The local time in milliseconds when it was sent
+		 */
+		qint64 time;
+		/**
+		 * @brief The size of the datagram including the overhead of UDP and IP
+		 */
+		qsizetype bytes;
+		/**
+		 * @brief Whether the Client acknowledged it
+		 */
+		bool acknowledged = false;
+	};
+	/**
+	 * @brief The most recently sent Curver data, ordered by tick
+	 */
+	std::deque<Sent> history;
+	/**
+	 * @brief The number of broadcasts from one Curver data sent to the Client to the next one
+	 *
+	 * A value of 1 sends every broadcast, see Server::broadcastCurverData().
+	 */
+	unsigned interval = 1;
+	/**
+	 * @brief The number of broadcasts since the last Curver data sent to the Client
+	 */
+	unsigned skipped = 0;
+	/**
+	 * @brief The round trip time of the Client in milliseconds
+	 */
+	qint64 roundTripTime = 0;
+	/**
+	 * @brief The local time in milliseconds when the interval was adjusted the last time
+	 */
+	qint64 lastAdjustment = 0;
+	/**
+	 * @brief The local clock that all times refer to
+	 */
+	QElapsedTimer clock;
+};
@@ -1,30 +1,71 @@
 #include "server.hpp"
 
+#include <QRandomGenerator>
+
+// the number of broadcasted frames that clients may acknowledge, older acknowledgements result in absolute positions
+#define FRAME_HISTORY_SIZE 32
+
 Server::Server() {
 	connect(&tcpServer, &QTcpServer::acceptError, this, &Server::acceptError);
 	connect(&tcpServer, &QTcpServer::newConnection, this, &Server::newConnection);
 	connect(Settings::get(), &Settings::dimensionChanged, this, &Server::broadcastSettings);
+	connect(PlayerModel::get(), &PlayerModel::playerModelChanged, this, &Server::updateCurverIndices);
 	connect(&udpSocket, &QUdpSocket::errorOccurred, this, &Server::udpSocketError);
 	connect(&udpSocket, &QUdpSocket::readyRead, this, &Server::udpSocketReadyRead);
 	reListen(0);
 }
 
 Server::~Server() {
-	clients.clear();
+	connections.clear();
 }
 
 /**
  * @brief Broadcasts new Curver data to every Client
+ * @param snapshot The state to broadcast
  */
-void Server::broadcastCurverData() {
+void Server::broadcastCurverData(const Snapshot &snapshot) {
+	if (snapshot.roundStartTick > roundStartTick) {
+		// the snapshot already belongs to the new round, so it must carry the reset
+		roundStartTick = snapshot.roundStartTick;
+		resetRound();
+	}
 	if (++dataBroadcastIteration % Settings::get()->getNetworkCurverBlock() == 0) {
-		Packet::ServerCurverData p;
-		p.fill();
-		p.start = true;
-		// if reset is due, send reset and reset the reset flag
-		p.reset = resetDue;
-		resetDue = false;
-		broadcastPacket(p, true);
+		if (frameHistory.empty() || frameHistory.back().tick < snapshot.tick) {
+			frameHistory.emplace_back(snapshot);
+			if (frameHistory.size() > FRAME_HISTORY_SIZE) {
+				frameHistory.pop_front();
+			}
+		}
+		const Packet::CurverFrame &frame = frameHistory.back();
+		// every client gets the deltas against the newest frame it has confirmed, so all clients with the same base share the serialized packet
+		encodedFrames.clear();
+		for (auto &[id, c] : connections) {
+			// a client on a bad connection skips some broadcasts, but never the reset of a round
+			if (!c.udpAddress || (!c.rate.shouldSend() && !c.resetDue)) {
+				continue;
+			}
+			const Packet::CurverFrame *base = Packet::findFrame(frameHistory, c.ackedTick);
+			QByteArray &encoded = encodedFrames[((base ? base->tick : 0) << 1) | c.resetDue];
+			if (encoded.isEmpty()) {
+				Packet::ServerCurverData p;
+				p.fill(frame, snapshot.changingSegment, base);
+				p.start = true;
+				p.reset = c.resetDue;
+				encoded = p.toByteArray();
+				// without a motion the prediction is the last byte, every client appends its own instead
+				encoded.chop(1);
+			}
+			Packet::ServerCurverData prediction;
+			prediction.fillPrediction(snapshot, c.curverIndex);
+			prediction.writePrediction(c.prediction);
+			c.rate.sent(frame.tick, encoded.size() + c.prediction.size());
+			// the shared frame and the prediction leave as two parts of the same datagram, so the frame is never copied
+			datagramBatch.add(encoded, c.prediction, *c.udpAddress);
+			// reset was sent, so reset the reset flag
+			c.resetDue = false;
+		}
+		// the whole tick leaves with a single system call where possible
+		datagramBatch.send(udpSocket);
 	}
 }
 
@@ -59,10 +100,10 @@ void Server::broadcastSettings() {
 }
 
 /**
- * @brief Resets the current round
+ * @brief Makes the next Curver data sent to every Client reset the round
  */
 void Server::resetRound() {
-	resetDue = true;
+	std::ranges::for_each(connections, [](auto &c) { c.second.resetDue = true; });
 }
 
 /**
@@ -86,6 +127,24 @@ void Server::broadcastPlayerModel() {
 	broadcastPacket(p);
 }
 
+/**
+ * @brief Looks up the index of the Curver of every Client in the PlayerModel
+ *
+ * The indices change whenever a player is added or removed, so this is called for every change of the PlayerModel.
+ * Every packet can then look up the index of its Curver directly.
+ */
+void Server::updateCurverIndices() {
+	const auto &curvers = PlayerModel::get()->getCurvers();
+	std::unordered_map<const Curver *, int> indices;
+	for (size_t i = 0; i < curvers.size(); ++i) {
+		indices[curvers[i].get()] = i;
+	}
+	for (auto &[id, c] : connections) {
+		const auto it = indices.find(c.curver);
+		c.curverIndex = it != indices.end() ? it->second : -1;
+	}
+}
+
 /**
  * @brief Broadcasts a new Item event to every Client
  * @param spawned Whether the Item spawned or was triggered
@@ -122,7 +181,14 @@ void Server::newConnection() {
 	if (s) {
 		auto *curver = PlayerModel::get()->getNewPlayer();
 		curver->controller = Curver::Controller::CONTROLLER_REMOTE;
-		clients[s] = curver;
+		// the id must not be guessable, so that no one else can claim the UDP address of the client
+		quint32 id;
+		do {
+			id = QRandomGenerator::global()->generate();
+		} while (!id || connections.contains(id));
+		connections[id] = {s, curver};
+		socketIds[s] = id;
+		updateCurverIndices();
 		connect(s, &QTcpSocket::errorOccurred, this, &Server::socketError);
 		connect(s, &QTcpSocket::disconnected, this, &Server::socketDisconnect);
 		connect(s, &QTcpSocket::readyRead, this, &Server::socketReadyRead);
@@ -130,6 +196,9 @@ void Server::newConnection() {
 		// the username is not sent yet, so we cannot pretty print the name yet
 		broadcastChatMessage(s->peerAddress().toString() + " joined");
 		broadcastSettings();
+		Packet::ServerWelcome welcome;
+		welcome.playerId = id;
+		welcome.sendPacket(s);
 	}
 }
 
@@ -155,18 +224,27 @@ void Server::socketDisconnect() {
  */
 void Server::socketReadyRead() {
 	QTcpSocket *s = static_cast<QTcpSocket *>(sender());
-	QDataStream in(s);
-	bool illformedPacket = false;
-	while (s->bytesAvailable() && !illformedPacket) {
-		in.startTransaction();
-		auto packet = Packet::AbstractPacket::receivePacket(in, InstanceType::Client);
-		if (in.commitTransaction()) {
+	Connection *connection = connectionFromSocket(s);
+	if (!connection) {
+		return;
+	}
+	connection->frames.append(*s);
+	QByteArray frame;
+	// handling a packet might remove the client, so it is looked up again for every frame
+	while ((connection = connectionFromSocket(s)) && connection->frames.next(frame)) {
+		QDataStream in(frame);
+		auto packet = Packet::AbstractPacket::receivePacket(in, InstanceType::Client, packets);
+		if (in.status() == QDataStream::Ok) {
 			handlePacket(packet, s);
 		} else {
+			// the frame tells where the next packet starts, so only this one is lost
 			qDebug() << "received ill-formed packet";
-			illformedPacket = true;
 		}
 	}
+	if (connection && connection->frames.isCorrupt()) {
+		qDebug() << "received an invalid frame, closing the connection";
+		s->abort();
+	}
 }
 
 /**
@@ -190,13 +268,9 @@ void Server::udpSocketReadyRead() {
 		FullNetworkAddress client = {sender, port};
 		QDataStream udpStream(&datagram, QIODevice::ReadOnly);
 		udpStream.startTransaction();
-		auto packet = Packet::AbstractPacket::receivePacket(udpStream, InstanceType::Client);
+		auto packet = Packet::AbstractPacket::receivePacket(udpStream, InstanceType::Client, packets);
 		if (udpStream.commitTransaction()) {
 			handlePacket(packet, nullptr, client);
-			// subscribe client to updates if not yet subscribed
-			if (std::ranges::find(udpAddresses, client) == udpAddresses.end()) {
-				udpAddresses.push_back(client);
-			}
 		} else {
 			qInfo() << "Got an ill-formed UDP packet";
 		}
@@ -208,19 +282,18 @@ void Server::udpSocketReadyRead() {
  * @param s The socket that defines the Curver to remove
  */
 void Server::removePlayer(const QTcpSocket *s) {
-	auto it = std::ranges::find_if(clients, [=](const auto &c) { return c.first == s; });
-	if (it != clients.end()) {
-		auto *c = it->second;
-		// remove from TCP list (Qt will delete the socket later, when the server shuts down)
-		clients.erase(it);
-		// remove from UDP list
-		auto udpit = std::ranges::find_if(udpAddresses, [&](const auto &a) { return a.addr == s->peerAddress(); });
-		if (udpit != udpAddresses.cend()) {
-			udpAddresses.erase(udpit);
+	const auto it = socketIds.find(s);
+	if (it != socketIds.end()) {
+		const Connection c = connections.at(it->second);
+		// remove from the lookup tables (Qt will delete the socket later, when the server shuts down)
+		if (c.udpAddress) {
+			udpIds.erase(*c.udpAddress);
 		}
+		connections.erase(it->second);
+		socketIds.erase(it);
 		// remove from player model
-		PlayerModel::get()->removeCurver(c);
-		broadcastChatMessage(curverNetworkName(s, c) + " left the game");
+		PlayerModel::get()->removeCurver(c.curver);
+		broadcastChatMessage(curverNetworkName(s, c.curver) + " left the game");
 	}
 }
 
@@ -230,18 +303,18 @@ void Server::removePlayer(const QTcpSocket *s) {
  * @param s The socket that the packet was received with
  * @param sender The sender of the packet, if sent via UDP
  */
-void Server::handlePacket(std::unique_ptr<Packet::AbstractPacket> &p, const QTcpSocket *s, FullNetworkAddress sender) {
-	Curver *curver = nullptr;
-	if (s != nullptr) {
-		curver = curverFromSocket(s);
-	}
+void Server::handlePacket(Packet::AbstractPacket *p, const QTcpSocket *s, FullNetworkAddress sender) {
+	// packets change the players, which the simulation thread is reading
+	std::scoped_lock lock(PlayerModel::get()->mutex);
+	const auto packetType = static_cast<Packet::ClientTypes>(p->type);
+	Connection *connection = s != nullptr ? connectionFromSocket(s) : connectionFromAddress(sender);
+	Curver *curver = connection ? connection->curver : nullptr;
 	// packet types that require curver to be set
 	const std::array<Packet::ClientTypes, 3> needsCurver = {
 		Packet::ClientTypes::Chat_Message,
 		Packet::ClientTypes::PlayerModelEdit,
 		Packet::ClientTypes::CurverRotation,
 	};
-	const auto packetType = static_cast<Packet::ClientTypes>(p->type);
 	if (curver == nullptr && std::ranges::find(needsCurver, packetType) != needsCurver.end()) {
 		qDebug() << "curver is not set";
 		return;
@@ -250,13 +323,13 @@ void Server::handlePacket(std::unique_ptr<Packet::AbstractPacket> &p, const QTcp
 	switch (packetType) {
 	case Packet::ClientTypes::Chat_Message:
 		{
-			QString msg = ((Packet::ClientChatMsg *) p.get())->message;
+			QString msg = ((Packet::ClientChatMsg *) p)->message;
 			broadcastChatMessage(curver->userName, msg);
 			break;
 		}
 	case Packet::ClientTypes::PlayerModelEdit:
 		{
-			auto *playerData = (Packet::ClientPlayerModel *) p.get();
+			auto *playerData = (Packet::ClientPlayerModel *) p;
 			curver->userName = playerData->username;
 			curver->setColor(playerData->color);
 			PlayerModel::get()->forceRefresh();
@@ -264,19 +337,34 @@ void Server::handlePacket(std::unique_ptr<Packet::AbstractPacket> &p, const QTcp
 		}
 	case Packet::ClientTypes::CurverRotation:
 		{
-			if (curver) {
-				curver->rotation = ((Packet::ClientCurverRotation *) p.get())->rotation;
+			auto *rotation = (Packet::ClientCurverRotation *) p;
+			// datagrams repeat inputs and may arrive out of order, the Curver replays those it did not get yet
+			curver->queueInputs(rotation->sequence, rotation->rotations);
+			break;
+		}
+	case Packet::ClientTypes::SnapshotAck:
+		{
+			const quint64 tick = ((Packet::SnapshotAck *) p)->tick;
+			// acknowledgements may arrive out of order, only the newest one matters
+			if (connection) {
+				connection->ackedTick = std::max(connection->ackedTick, tick);
+				connection->rate.acknowledged(tick);
 			}
 			break;
 		}
 	case Packet::ClientTypes::Ping:
 		{
-			auto *pingPacket = (Packet::Ping *) p.get();
+			auto *pingPacket = (Packet::Ping *) p;
+			bindUdpAddress(pingPacket->playerId, sender);
+			connection = connectionFromAddress(sender);
 			// respond with pong
 			Packet::Pong pongPacket;
 			pongPacket.sent = pingPacket->sent;
-			pongPacket.curverIndex = getCurverIndex(sender);
+			pongPacket.curverIndex = connection ? connection->curverIndex : -1;
 
+			if (connection) {
+				connection->rate.setRoundTripTime(pingPacket->delta);
+			}
 			if (pongPacket.curverIndex != -1) {
 				// store current ping of this player
 				PlayerModel::get()->getCurvers()[pongPacket.curverIndex]->ping = pingPacket->delta;
@@ -294,35 +382,38 @@ void Server::handlePacket(std::unique_ptr<Packet::AbstractPacket> &p, const QTcp
 }
 
 /**
- * @brief Broadcasts a packet to every Client
+ * @brief Broadcasts a packet to every Client over TCP
  * @param p The packet to broadcast
- * @param udp Whether to broadcast using UDP or TCP
  */
-void Server::broadcastPacket(Packet::AbstractPacket &p, bool udp) {
-	if (udp) {
-		std::ranges::for_each(udpAddresses, [&](auto &c) { p.sendPacketUdp(&udpSocket, c); });
-	} else {
-		std::ranges::for_each(clients, [&](auto &c) { p.sendPacket(c.first); });
-	}
+void Server::broadcastPacket(Packet::AbstractPacket &p) {
+	// the packet is serialized once, every client gets the same implicitly shared buffer
+	const QByteArray frame = p.toFrame();
+	std::ranges::for_each(connections, [&](auto &c) { c.second.socket->write(frame); });
 }
 
 /**
- * @brief Computes the index belonging to a client
- * @param peer The address of the client
- * @return The index in the server-side curver array
+ * @brief Binds a UDP address to the Client with the given player id
+ *
+ * If the Client was bound to another address before, e.g. because its NAT changed the port, the old address is released.
+ * The newest binding of an address wins.
+ * @param playerId The player id that the Client sent
+ * @param address The UDP address of the Client
  */
-int Server::getCurverIndex(const FullNetworkAddress peer) {
-	auto it = std::ranges::find_if(clients, [&](const auto &p) { return p.first->peerAddress() == peer.addr; });
-	if (it != clients.cend()) {
-		auto &curvers = PlayerModel::get()->getCurvers();
-		for (size_t i = 0; i < curvers.size(); ++i) {
-			if (curvers[i].get() == it->second) {
-				return i;
-			}
-		}
+void Server::bindUdpAddress(const quint32 playerId, const FullNetworkAddress &address) {
+	const auto it = connections.find(playerId);
+	if (it == connections.end() || it->second.udpAddress == address) {
+		return;
+	}
+	const auto previous = udpIds.find(address);
+	if (previous != udpIds.end()) {
+		// the address belonged to another client before, e.g. an old session of this client that did not time out yet
+		connections.at(previous->second).udpAddress.reset();
 	}
-	qDebug() << "Client index not found" << peer.addr << peer.port;
-	return -1;
+	if (it->second.udpAddress) {
+		udpIds.erase(*it->second.udpAddress);
+	}
+	it->second.udpAddress = address;
+	udpIds[address] = playerId;
 }
 
 /**
@@ -336,15 +427,21 @@ QString Server::curverNetworkName(const QTcpSocket *s, const Curver *curver) {
 }
 
 /**
- * @brief Returns the Curver connected to a given socket
- * @param s The socket to return the Curver of
- * @return The Curver that belongs to \a s
+ * @brief Returns the Client connected with a given socket
+ * @param s The TCP socket of the Client
+ * @return The Client or \c nullptr, if \a s does not belong to any
  */
-Curver *Server::curverFromSocket(const QTcpSocket *s) const {
-	auto it = std::ranges::find_if(clients, [&](const auto &c) { return c.first == s; });
-	if (it != clients.cend()) {
-		return it->second;
-	} else {
-		return nullptr;
-	}
+Server::Connection *Server::connectionFromSocket(const QTcpSocket *s) {
+	const auto it = socketIds.find(s);
+	return it != socketIds.end() ? &connections.at(it->second) : nullptr;
+}
+
+/**
+ * @brief Returns the Client with a given UDP address
+ * @param address The UDP address of the Client
+ * @return The Client or \c nullptr, if \a address does not belong to any
+ */
+Server::Connection *Server::connectionFromAddress(const FullNetworkAddress &address) {
+	const auto it = udpIds.find(address);
+	return it != udpIds.end() ? &connections.at(it->second) : nullptr;
 }
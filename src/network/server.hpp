@@ -6,8 +6,13 @@
 #include <QtNetwork>
 #include <array>
 #include <memory>
+#include <optional>
+#include <unordered_map>
 
+#include "datagrambatch.hpp"
+#include "framebuffer.hpp"
 #include "network.hpp"
+#include "ratecontrol.hpp"
 
 #define ADMIN_NAME "Chat Bot"
 
@@ -22,14 +27,14 @@ public:
 	explicit Server();
 	~Server();
 
-	void broadcastCurverData();
+	void broadcastCurverData(const Snapshot &snapshot);
 	void broadcastChatMessage(QString username, QString message);
 	void broadcastChatMessage(QString msg);
 	void broadcastSettings();
-	void resetRound();
 	void reListen(quint16 port);
 public slots:
 	void broadcastPlayerModel();
+	void updateCurverIndices();
 	void broadcastItemData(bool spawned, unsigned int sequenceNumber, int which, QPointF pos, Item::AllowedUsers allowedUsers, int collectorIndex);
 private slots:
 	// tcpServer
@@ -43,10 +48,59 @@ private slots:
 	void udpSocketError(QAbstractSocket::SocketError);
 	void udpSocketReadyRead();
 private:
+	/**
+	 * @brief A Client connected to the Server
+	 */
+	struct Connection {
+		/**
+		 * @brief The TCP socket of the Client
+		 *
+		 * We do not need to delete the QTcpSocket instances, Qt manages the lifetime of them and will delete them once the server goes down.
+		 */
+		QTcpSocket *socket;
+		/**
+		 * @brief The Curver controlled by the Client
+		 */
+		Curver *curver;
+		/**
+		 * @brief The index of Connection::curver in the PlayerModel, see updateCurverIndices()
+		 */
+		int curverIndex = -1;
+		/**
+		 * @brief The UDP address of the Client, once it sent a Ping with its player id
+		 */
+		std::optional<FullNetworkAddress> udpAddress;
+		/**
+		 * @brief The newest frame that the Client acknowledged, or \c 0 if there is none
+		 */
+		quint64 ackedTick = 0;
+		/**
+		 * @brief The bytes received on Connection::socket, that are split into packets
+		 */
+		FrameBuffer frames;
+		/**
+		 * @brief The rate of Curver data sent to the Client
+		 */
+		RateControl rate;
+		/**
+		 * @brief The serialized prediction last sent to the Client, kept to reuse its allocation
+		 */
+		QByteArray prediction;
+		/**
+		 * @brief Whether the round has to be reset
+		 *
+		 * The next update of Curver data sent to the Client resets this flag, after sending the reset bit
+		 */
+		bool resetDue = false;
+	};
+
+	void resetRound();
 	void removePlayer(const QTcpSocket *s);
-	void handlePacket(std::unique_ptr<Packet::AbstractPacket> &p, const QTcpSocket *s = nullptr, FullNetworkAddress sender = {});
-	void broadcastPacket(Packet::AbstractPacket &p, bool udp = false);
-	int getCurverIndex(const FullNetworkAddress peer);
+	void handlePacket(Packet::AbstractPacket *p, const QTcpSocket *s = nullptr, FullNetworkAddress sender = {});
+	void broadcastPacket(Packet::AbstractPacket &p);
+	void bindUdpAddress(const quint32 playerId, const FullNetworkAddress &address);
+	Connection *connectionFromSocket(const QTcpSocket *s);
+	Connection *connectionFromAddress(const FullNetworkAddress &address);
 	QString curverNetworkName(const QTcpSocket *s, const Curver *curver);
 	/**
 	 * @brief The server instance that handles every incoming connection
@@ -57,18 +111,26 @@ private:
 	 */
 	QUdpSocket udpSocket;
 	/**
-	 * @brief The mapping between TCP sockets and their Curver instances
+	 * @brief The instances that received packets are parsed into
+	 */
+	Packet::PacketPool packets;
+	/**
+	 * @brief All connected Clients by their player id
 	 *
-	 * We do not need to delete the QTcpSocket instances, Qt manages the lifetime of them and will delete them once the server goes down.
+	 * The player id is a random number, that the Server tells a Client over TCP, see Packet::ServerWelcome.
+	 * The Client proves with it, which UDP address belongs to which TCP connection.
+	 */
+	std::unordered_map<quint32, Connection> connections;
+	/**
+	 * @brief The player ids by TCP socket
 	 */
-	std::map<QTcpSocket *, Curver *> clients;
-	Curver *curverFromSocket(const QTcpSocket *s) const;
+	std::unordered_map<const QTcpSocket *, quint32> socketIds;
 	/**
-	 * @brief Whether the round has to be reset
+	 * @brief The player ids by UDP address
 	 *
-	 * Usually the next update of Curver data resets this flag, after sending the reset bit to every Client
+	 * The port is part of the key, so several Clients behind the same NAT are told apart.
 	 */
-	bool resetDue = false;
+	std::unordered_map<FullNetworkAddress, quint32> udpIds;
 	/**
 	 * @brief The amount of times that curver data was broadcasted
 	 *
@@ -76,7 +138,22 @@ private:
 	 */
 	unsigned dataBroadcastIteration = 0;
 	/**
-	 * @brief The UDP addresses from all clients
+	 * @brief The Snapshot::roundStartTick of the last round reset that was passed on to the Clients
+	 */
+	quint64 roundStartTick = 0;
+	/**
+	 * @brief The most recently broadcasted frames, which Curver data is delta encoded against
+	 */
+	std::deque<Packet::CurverFrame> frameHistory;
+	/**
+	 * @brief The serialized Curver data of the current broadcast by the tick of the frame that it is delta encoded against
+	 *
+	 * The lowest bit of the key is the reset flag, which is only set for Clients that did not receive the reset yet.
+	 * A member, so that the buckets are kept from one broadcast to the next.
+	 */
+	std::unordered_map<quint64, QByteArray> encodedFrames;
+	/**
+	 * @brief The datagrams of the current broadcast, which are sent together
 	 */
-	std::vector<FullNetworkAddress> udpAddresses;
+	DatagramBatch datagramBatch;
 };
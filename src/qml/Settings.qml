@@ -87,6 +87,28 @@ Page {
 					stepSize: 1
 					onValueChanged: Settings.setNetworkCurverBlock(value);
 				}
+				Label {
+					text: "Network bandwidth per player"
+				}
+				Slider {
+					height: 24
+					value: Settings.getNetworkBandwidth();
+					from: 2
+					to: 64
+					snapMode: Slider.SnapAlways
+					stepSize: 1
+					onValueChanged: Settings.setNetworkBandwidth(value);
+				}
+				Label {
+					text: "Interpolation delay"
+				}
+				Slider {
+					height: 24
+					value: Settings.getInterpolationDelay();
+					from: 0
+					to: 300
+					onValueChanged: Settings.setInterpolationDelay(value);
+				}
 			}
 		}
 		Item {
@@ -0,0 +1,85 @@
+#include "random.hpp"
+
+#include <bit>
+#include <iterator>
+
+#include "util.hpp"
+
+/**
+ * @brief Constructs a Random generator
+ * @param seed The seed to start with
+ */
+Random::Random(const quint64 seed) {
+	this->seed(seed);
+}
+
+/**
+ * @brief Restarts the generator from a seed
+ *
+ * The same seed always results in the same sequence of numbers.
+ * @param seed The new seed
+ */
+void Random::seed(quint64 seed) {
+	// splitmix64 spreads the bits of similar seeds over the whole state
+	for (auto &s : state) {
+		seed += 0x9E3779B97F4A7C15;
+		quint64 z = seed;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+		s = z ^ (z >> 31);
+	}
+}
+
+/**
+ * @brief Returns the next raw number of the sequence
+ * @return A random 64 bit number
+ */
+quint64 Random::next() {
+	const quint64 result = std::rotl(state[1] * 5, 7) * 9;
+	const quint64 t = state[1] << 17;
+	state[2] ^= state[0];
+	state[3] ^= state[1];
+	state[1] ^= state[2];
+	state[0] ^= state[3];
+	state[2] ^= t;
+	state[3] = std::rotl(state[3], 45);
+	return result;
+}
+
+/**
+ * @brief Returns a random number between 0 and 1
+ * @return A random number between 0 and 1
+ */
+double Random::rand() {
+	// the upper 53 bits fill the mantissa exactly
+	return (next() >> 11) * 0x1.0p-53;
+}
+
+/**
+ * @brief Returns a random QPointF with values between 0 and 1 each
+ * @return A random QPointF
+ */
+QPointF Random::randQPointF() {
+	const double x = rand();
+	return QPointF(x, rand());
+}
+
+/**
+ * @brief Returns a random integer in the given range
+ * @param lower Lower boundary
+ * @param upper Upper boundary
+ * @return A random integer in the given range
+ */
+int Random::randInt(const int lower, const int upper) {
+	return lower + rand() * (upper - lower);
+}
+
+/**
+ * @brief Returns a random Material design color
+ * @return A random color
+ */
+QColor Random::randColor() {
+	auto it = Util::colors.begin();
+	std::advance(it, randInt(0, static_cast<int>(Util::colors.size()) - 1));
+	return it->second;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <QColor>
+#include <QPointF>
+#include <QtGlobal>
+#include <array>
+
+/**
+ * @brief A fast seedable pseudo random number generator
+ *
+ * Implements xoshiro256**, the state is initialized from the seed with splitmix64.
+ * Every Game owns its own instance, so a game can be replayed from its seed and there is no contention on a shared generator.
+ * An instance is not thread-safe, it must only be used while holding the lock that protects the rest of the game state.
+ */
+class Random {
+public:
+	explicit Random(const quint64 seed = 0);
+
+	void seed(quint64 seed);
+	quint64 next();
+	double rand();
+	QPointF randQPointF();
+	int randInt(const int lower, const int upper);
+	QColor randColor();
+private:
+	/**
+	 * @brief The internal state of the generator
+	 */
+	std::array<quint64, 4> state;
+};
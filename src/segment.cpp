@@ -1,25 +1,31 @@
 #include "segment.hpp"
 
+#include <QtMath>
+#include <algorithm>
+#include <limits>
+
+#include "intersection.hpp"
+#include "segmentnode.hpp"
+
+#define SEGMENT_CHUNK_SIZE 64
+
 /**
  * @brief Constructs a Segment with the given parent node, material and thickness
- * @param parentNode The parent node in the scene graph
+ * @param parentNode The parent node in the scene graph, or \c nullptr to not render the segment at all
  * @param material The material to use for all drawing calls
  * @param thickness The thickness of the segment
+ * @param grid The grid to register all edges in for collision queries
  */
-Segment::Segment(QSGNode *parentNode, QSGFlatColorMaterial *material, const float thickness) {
-	this->parentNode = parentNode;
+Segment::Segment(QSGNode *parentNode, QSGFlatColorMaterial *material, const float thickness, SpatialGrid *grid) {
 	this->thickness = thickness;
-
-	geometry.setLineWidth(thickness);
-	geometry.setDrawingMode(QSGGeometry::DrawTriangleStrip);
-	geoNode.setGeometry(&geometry);
-	geoNode.setMaterial(material);
-	geometry.allocate(1);
-	parentNode->appendChildNode(&geoNode);
+	this->grid = grid;
+	if (parentNode) {
+		node = std::make_unique<SegmentNode>(parentNode, material, thickness);
+	}
 }
 
 Segment::~Segment() {
-	parentNode->removeChildNode(&geoNode);
+	setGrid(nullptr);
 }
 
 /**
@@ -28,11 +34,25 @@ Segment::~Segment() {
  * @param angle The angle to append the point with. The thickness of the line spreads orthogonal relative to the angle
  */
 void Segment::appendPoint(const QPointF newPoint, const float angle) {
+	if (firstPoint > getSegmentSize()) {
+		compact();
+	}
 	const float normalAngle = angle + M_PI / 2;
 	const QPointF normalVector = thickness * QPointF(cos(normalAngle), sin(normalAngle));
 	pos.push_back(newPoint + normalVector);
+	extendBoundingBoxes(pos.back());
 	pos.push_back(newPoint - normalVector);
-	updateGeometry();
+	extendBoundingBoxes(pos.back());
+	posX.push_back(newPoint.x() + normalVector.x());
+	posY.push_back(newPoint.y() + normalVector.y());
+	posX.push_back(newPoint.x() - normalVector.x());
+	posY.push_back(newPoint.y() - normalVector.y());
+	if (node) {
+		node->append(pos, firstPoint, 2);
+	}
+	// the new points complete two more edges, see checkForIntersection()
+	registerEdge(pos.size() - 3);
+	registerEdge(pos.size() - 2);
 
 	lastPoint = newPoint;
 }
@@ -44,50 +64,37 @@ void Segment::appendPoint(const QPointF newPoint, const float angle) {
  * @return \c True, iif this segment intersects with the line a -> b
  */
 bool Segment::checkForIntersection(QPointF a, QPointF b) const {
-	/* Given a line (a -- b) and (c -- d), we find an intersection as follows:
-	 *
-	 * First compute the equation A*x + B*y = C for both lines
-	 * A = b.y - a.y
-	 * B = a.x - b.x
-	 * C = A*a.x + B*a.y
-	 *
-	 * Then for two lines 1 and 2 in this form, first check if
-	 * det := A1*B2 - A2*B1 == 0 => Lines are parallel
-	 * If this is the case, check if the lines intersect using a bounding rectangle
-	 *
-	 * Otherwise compute the location of the intersection as follows:
-	 * x := (B2*C1 - B1*C2)/det
-	 * y := (A1*C2 - A2*C1)/det
-	 *
-	 * Finally check if this intersection location is contained in both lines
-	*/
-	// epsilon is needed, because floating point operations are not that nice, when it comes to comparing them
-	const float epsilon = 0.015625;
-	const float firstA = b.y() - a.y();
-	const float firstB = a.x() - b.x();
-	const float firstC = firstA * a.x() + firstB * a.y();
-	const float minX = std::min(a.x(), b.x()) - epsilon;
-	const float maxX = std::max(a.x(), b.x()) + epsilon;
-	const float minY = std::min(a.y(), b.y()) - epsilon;
-	const float maxY = std::max(a.y(), b.y()) + epsilon;
-	for (int i = 2; i < static_cast<int>(pos.size() - 1); ++i) {
-		const QPointF c = pos[i - 2];
-		const QPointF d = pos[i];
-		const float secondA = d.y() - c.y();
-		const float secondB = c.x() - d.x();
-		const float secondC = secondA * c.x() + secondB * c.y();
-		const float det = firstA * secondB - secondA * firstB;
-		if (static_cast<bool>(det)) {
-			// not parallel
-			const float x = (secondB * firstC - firstB * secondC) / det;
-			const float y = (firstA * secondC - secondA * firstC) / det;
-			// is the intersection location contained in both lines?
-			if (minX <= x && x <= maxX && minY <= y && y <= maxY &&
-				(std::min(c.x(), d.x()) - epsilon) <= x && (x <= std::max(c.x(), d.x()) + epsilon) &&
-				(std::min(c.y(), d.y()) - epsilon) <= y && (y <= std::max(c.y(), d.y()) + epsilon)) {
-				return true;
-			}
+	return checkForIntersection(a, b, 0, std::numeric_limits<size_t>::max());
+}
+
+/**
+ * @brief Checks if a range of edges of this segment collides with a line from a to b
+ *
+ * The edge with index i connects the points i-2 and i, where indices are counted from the very first point ever appended.
+ * @param a The start point of the line
+ * @param b The end point of the line
+ * @param firstEdge The index of the first edge to check
+ * @param lastEdge The index of the last edge to check (inclusive)
+ * @return \c True, iif any edge in the given range intersects with the line a -> b
+ */
+bool Segment::checkForIntersection(QPointF a, QPointF b, size_t firstEdge, size_t lastEdge) const {
+	const auto line = Intersection::makeLine(a, b);
+	// edges run from the third up to the second last remaining point
+	if (getSegmentSize() < 4 || lastEdge < poppedPoints + 2 || !boundingBox.overlaps(line.minX, line.maxX, line.minY, line.maxY, Intersection::epsilon)) {
+		return false;
+	}
+	// the edge index of Segment::pos[0]
+	const size_t base = poppedPoints - firstPoint;
+	const size_t begin = std::max(firstEdge, poppedPoints + 2) - base;
+	const size_t end = std::min(lastEdge, base + pos.size() - 2) - base;
+	for (size_t i = begin; i <= end;) {
+		// skip the entire chunk, if its bounding box is out of reach
+		const size_t chunk = (base + i) / SEGMENT_CHUNK_SIZE;
+		const size_t chunkEnd = std::min(end, (chunk + 1) * SEGMENT_CHUNK_SIZE - 1 - base);
+		if (chunkBoxes[chunk - firstChunk].overlaps(line.minX, line.maxX, line.minY, line.maxY, Intersection::epsilon) && Intersection::checkEdges(line, posX.data(), posY.data(), i, chunkEnd)) {
+			return true;
 		}
+		i = chunkEnd + 1;
 	}
 	return false;
 }
@@ -97,27 +104,55 @@ bool Segment::checkForIntersection(QPointF a, QPointF b) const {
  * @return The total internal amount of points stored in this segment
  */
 size_t Segment::getSegmentSize() const {
-	return pos.size();
+	return pos.size() - firstPoint;
 }
 
 /**
  * @brief Removes points from the beginning of the segment
+ *
+ * The points are not moved, only the window of remaining points shrinks, so this takes time proportional to \a amount.
+ * The space of the removed points is reclaimed later on, see compact().
  * @param amount The number of points to remove
  */
 void Segment::popPoints(const size_t amount) {
 	if (!amount) {
 		return;
 	}
-	pos.erase(pos.begin(), pos.begin() + amount);
-	updateGeometry();
+	if (amount >= getSegmentSize()) {
+		clear();
+		return;
+	}
+	const size_t oldFirstPoint = firstPoint;
+	firstPoint += amount;
+	poppedPoints += amount;
+	// drop the boxes of chunks without any remaining edge
+	const size_t obsoleteChunks = std::min(chunkBoxes.size(), (poppedPoints + 2) / SEGMENT_CHUNK_SIZE - firstChunk);
+	chunkBoxes.erase(chunkBoxes.begin(), chunkBoxes.begin() + obsoleteChunks);
+	firstChunk += obsoleteChunks;
+	if (node) {
+		node->pop(pos, oldFirstPoint, firstPoint);
+	}
 }
 
 /**
  * @brief Removes all points from this segment
  */
 void Segment::clear() {
+	if (grid) {
+		grid->remove(this, gridCells);
+	}
+	gridCells = QRect();
+	poppedPoints += getSegmentSize();
+	boundingBox = BoundingBox();
+	chunkBoxes.clear();
+	firstChunk = poppedPoints / SEGMENT_CHUNK_SIZE;
+	firstPoint = 0;
 	pos.clear();
-	updateGeometry();
+	posX.clear();
+	posY.clear();
+	if (node) {
+		node->update(pos, firstPoint);
+	}
 }
 
 /**
@@ -126,20 +161,101 @@ void Segment::clear() {
  */
 std::optional<QPointF> Segment::getFirstPos() const {
 	if (getSegmentSize()) {
-		return pos.front();
+		return pos[firstPoint];
 	} else {
 		return std::nullopt;
 	}
 }
 
 /**
- * @brief Updates the geometry of the geometry node and flags it dirty for the renderer
+ * @brief Moves the remaining points to the front of Segment::pos, discarding the removed points
+ *
+ * This is only done once the removed points outnumber the remaining ones, so the cost stays amortized constant per removed point.
+ */
+void Segment::compact() {
+	if (!firstPoint) {
+		return;
+	}
+	pos.erase(pos.begin(), pos.begin() + firstPoint);
+	posX.erase(posX.begin(), posX.begin() + firstPoint);
+	posY.erase(posY.begin(), posY.begin() + firstPoint);
+	firstPoint = 0;
+	if (node) {
+		node->update(pos, firstPoint);
+	}
+}
+
+/**
+ * @brief Changes the grid that this segment registers its edges in
+ *
+ * All edges are removed from the old grid. Passing \c nullptr detaches the segment, so it no longer takes part in collision queries.
+ * @param grid The new grid
+ */
+void Segment::setGrid(SpatialGrid *grid) {
+	if (this->grid) {
+		this->grid->remove(this, gridCells);
+	}
+	gridCells = QRect();
+	this->grid = grid;
+	if (grid) {
+		for (size_t i = firstPoint + 2; i + 1 < pos.size(); ++i) {
+			registerEdge(i);
+		}
+	}
+}
+
+/**
+ * @brief Registers an edge in the grid
+ * @param i The index of the edge in Segment::pos
+ */
+void Segment::registerEdge(const size_t i) {
+	if (!grid || i < firstPoint + 2 || i >= pos.size()) {
+		return;
+	}
+	grid->insertEdge(this, poppedPoints - firstPoint + i, pos[i - 2], pos[i]);
+	gridCells |= grid->cellsCovering(pos[i - 2], pos[i]);
+}
+
+/**
+ * @brief Extends the bounding boxes with a point that was just appended to Segment::pos
+ *
+ * The point is used by the edge ending in it and by the edge starting in it, which may belong to different chunks.
+ * @param p The new point
  */
-void Segment::updateGeometry() {
-	geometry.allocate(pos.size());
-	QSGGeometry::Point2D *vertices = geometry.vertexDataAsPoint2D();
-	for (size_t i = 0; i < pos.size(); ++i) {
-		vertices[i].set(pos[i].x(), pos[i].y());
+void Segment::extendBoundingBoxes(const QPointF p) {
+	const size_t index = poppedPoints - firstPoint + pos.size() - 1;
+	boundingBox.extend(p);
+	const size_t lastChunk = (index + 2) / SEGMENT_CHUNK_SIZE;
+	if (chunkBoxes.size() < lastChunk - firstChunk + 1) {
+		chunkBoxes.resize(lastChunk - firstChunk + 1);
 	}
-	geoNode.markDirty(QSGNode::DirtyGeometry);
+	// the edge ending in the point does not exist, if the point two before it was already popped, and its chunk may precede Segment::firstChunk
+	if (index >= poppedPoints + 2) {
+		chunkBoxes[index / SEGMENT_CHUNK_SIZE - firstChunk].extend(p);
+	}
+	chunkBoxes[lastChunk - firstChunk].extend(p);
+}
+
+/**
+ * @brief Grows the bounding box to contain a point
+ * @param p The point to contain
+ */
+void Segment::BoundingBox::extend(const QPointF p) {
+	minX = std::min(minX, p.x());
+	maxX = std::max(maxX, p.x());
+	minY = std::min(minY, p.y());
+	maxY = std::max(maxY, p.y());
+}
+
+/**
+ * @brief Checks if the bounding box grown by \a margin overlaps a given rectangle
+ * @param minX The smallest x coordinate of the rectangle
+ * @param maxX The largest x coordinate of the rectangle
+ * @param minY The smallest y coordinate of the rectangle
+ * @param maxY The largest y coordinate of the rectangle
+ * @param margin The margin to grow the bounding box by on each side
+ * @return \c True, iif both overlap
+ */
+bool Segment::BoundingBox::overlaps(const float minX, const float maxX, const float minY, const float maxY, const float margin) const {
+	return minX <= this->maxX + margin && this->minX - margin <= maxX && minY <= this->maxY + margin && this->minY - margin <= maxY;
 }
@@ -1,54 +1,127 @@
 #pragma once
 
-#include <QQuickItem>
-#include <QSGFlatColorMaterial>
-#include <QSGNode>
-#include <QtMath>
+#include <QObject>
+#include <QPointF>
+#include <QRect>
+#include <deque>
+#include <limits>
 #include <memory>
 #include <optional>
+#include <vector>
+
+#include "spatialgrid.hpp"
+
+class QSGNode;
+class QSGFlatColorMaterial;
+class SegmentNode;
 
 /**
  * @brief A class representing a segment of a line
  *
  * Every Curver consists of multiple Segment lines. This class represents a single instance of such a line.
+ * It only stores the points and answers collision queries, rendering is left to an optional SegmentNode.
  */
 class Segment : public QObject {
 	Q_OBJECT
 public:
-	explicit Segment(QSGNode *parentNode, QSGFlatColorMaterial *material, const float thickness);
+	explicit Segment(QSGNode *parentNode, QSGFlatColorMaterial *material, const float thickness, SpatialGrid *grid = nullptr);
 	~Segment();
 
 	void appendPoint(const QPointF newPoint, const float angle);
 	bool checkForIntersection(QPointF a, QPointF b) const;
+	bool checkForIntersection(QPointF a, QPointF b, size_t firstEdge, size_t lastEdge) const;
+	void setGrid(SpatialGrid *grid);
 	size_t getSegmentSize() const;
 	void popPoints(const size_t amount);
 	void clear();
 	std::optional<QPointF> getFirstPos() const;
 private:
-	void updateGeometry();
-
 	/**
-	 * @brief The parent node in the scene graph
+	 * @brief An axis-aligned bounding box that grows with every point added to it
 	 */
-	QSGNode *parentNode;
+	struct BoundingBox {
+		void extend(const QPointF p);
+		bool overlaps(const float minX, const float maxX, const float minY, const float maxY, const float margin) const;
+		/**
+		 * @brief The smallest x coordinate
+		 */
+		qreal minX = std::numeric_limits<qreal>::infinity();
+		/**
+		 * @brief The largest x coordinate
+		 */
+		qreal maxX = -std::numeric_limits<qreal>::infinity();
+		/**
+		 * @brief The smallest y coordinate
+		 */
+		qreal minY = std::numeric_limits<qreal>::infinity();
+		/**
+		 * @brief The largest y coordinate
+		 */
+		qreal maxY = -std::numeric_limits<qreal>::infinity();
+	};
+
+	void compact();
+	void registerEdge(const size_t i);
+	void extendBoundingBoxes(const QPointF p);
+
 	/**
 	 * @brief The thickness of the line
 	 */
 	float thickness;
 	/**
-	 * @brief The node representing this Segment in the scene graph
+	 * @brief The node rendering this Segment, or \c nullptr if there is no scene graph
+	 */
+	std::unique_ptr<SegmentNode> node;
+	/**
+	 * @brief Every position of the outline of this Segment
 	 */
-	QSGGeometryNode geoNode;
+	std::vector<QPointF> pos;
 	/**
-	 * @brief The geometry of this Segment.
+	 * @brief The index of the first point in Segment::pos that was not removed with popPoints() yet
+	 *
+	 * The removed points in front of it are discarded by compact(), once they outnumber the remaining points.
 	 */
-	QSGGeometry geometry = QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+	size_t firstPoint = 0;
 	/**
-	 * @brief Every position that has to be stored in Segment::geometry.
+	 * @brief The x coordinates of Segment::pos
+	 *
+	 * Together with Segment::posY this is a structure-of-arrays copy of Segment::pos, which the SIMD intersection test can load directly.
 	 */
-	std::vector<QPointF> pos;
+	std::vector<double> posX;
+	/**
+	 * @brief The y coordinates of Segment::pos
+	 */
+	std::vector<double> posY;
 	/**
 	 * @brief The last point that was added to this Segment.
 	 */
 	QPointF lastPoint;
+	/**
+	 * @brief The amount of points that were removed from the front with popPoints()
+	 *
+	 * Edge indices handed out to the SpatialGrid are counted from the very first point, so they stay valid after points are removed.
+	 */
+	size_t poppedPoints = 0;
+	/**
+	 * @brief The bounding box of all points in this Segment
+	 */
+	BoundingBox boundingBox;
+	/**
+	 * @brief The bounding boxes of the edges, grouped into chunks of SEGMENT_CHUNK_SIZE consecutive edges
+	 *
+	 * The first box belongs to the chunk Segment::firstChunk.
+	 */
+	std::deque<BoundingBox> chunkBoxes;
+	/**
+	 * @brief The chunk index of the first box in Segment::chunkBoxes
+	 */
+	size_t firstChunk = 0;
+	/**
+	 * @brief The grid that this Segment registers its edges in, or \c nullptr
+	 */
+	SpatialGrid *grid = nullptr;
+	/**
+	 * @brief The cells of Segment::grid that this Segment has registered edges in
+	 */
+	QRect gridCells;
 };
@@ -0,0 +1,113 @@
+#include "segmentnode.hpp"
+
+#include <algorithm>
+
+#define SEGMENT_NODE_MIN_CAPACITY 64
+
+/**
+ * @brief Constructs a SegmentNode and attaches it to the scene graph
+ * @param parentNode The parent node in the scene graph
+ * @param material The material to use for all drawing calls
+ * @param thickness The thickness of the segment
+ */
+SegmentNode::SegmentNode(QSGNode *parentNode, QSGFlatColorMaterial *material, const float thickness) {
+	this->parentNode = parentNode;
+
+	geometry.setLineWidth(thickness);
+	geometry.setDrawingMode(QSGGeometry::DrawTriangleStrip);
+	geometry.setVertexDataPattern(QSGGeometry::DynamicPattern);
+	geoNode.setGeometry(&geometry);
+	geoNode.setMaterial(material);
+	parentNode->appendChildNode(&geoNode);
+}
+
+SegmentNode::~SegmentNode() {
+	parentNode->removeChildNode(&geoNode);
+}
+
+/**
+ * @brief Rewrites the whole geometry
+ *
+ * The geometry is reallocated with twice the required capacity, so appending stays amortized constant time.
+ * The spare capacity is filled with copies of the last point.
+ * In a triangle strip these copies only form degenerate triangles, so they are never visible.
+ * @param pos All points of the Segment
+ * @param firstPoint The index of the first point in \a pos that was not removed yet
+ */
+void SegmentNode::update(const std::vector<QPointF> &pos, const size_t firstPoint) {
+	geometry.allocate(pos.empty() ? 0 : std::max(static_cast<size_t>(SEGMENT_NODE_MIN_CAPACITY), 2 * pos.size()));
+	QSGGeometry::Point2D *vertices = geometry.vertexDataAsPoint2D();
+	hideRemoved(pos, 0, firstPoint);
+	for (size_t i = firstPoint; i < pos.size(); ++i) {
+		vertices[i].set(pos[i].x(), pos[i].y());
+	}
+	for (size_t i = pos.size(); i < static_cast<size_t>(geometry.vertexCount()); ++i) {
+		vertices[i].set(pos.back().x(), pos.back().y());
+	}
+	markDirty();
+}
+
+/**
+ * @brief Writes points that were just appended to the Segment
+ *
+ * Only the new vertices and the first spare vertex are written.
+ * The first spare vertex repeats the last point, so the remaining spare vertices form degenerate triangles, no matter which point they repeat.
+ * @param pos All points of the Segment
+ * @param firstPoint The index of the first point in \a pos that was not removed yet
+ * @param count The number of points that were appended
+ */
+void SegmentNode::append(const std::vector<QPointF> &pos, const size_t firstPoint, const size_t count) {
+	const size_t capacity = geometry.vertexCount();
+	if (capacity < pos.size()) {
+		update(pos, firstPoint);
+		return;
+	}
+	QSGGeometry::Point2D *vertices = geometry.vertexDataAsPoint2D();
+	for (size_t i = pos.size() - count; i < pos.size(); ++i) {
+		vertices[i].set(pos[i].x(), pos[i].y());
+	}
+	if (pos.size() < capacity) {
+		vertices[pos.size()].set(pos.back().x(), pos.back().y());
+	}
+	markDirty();
+}
+
+/**
+ * @brief Hides points that were just removed from the front of the Segment
+ * @param pos All points of the Segment
+ * @param oldFirstPoint The index of the first remaining point before the removal
+ * @param firstPoint The index of the first remaining point after the removal
+ */
+void SegmentNode::pop(const std::vector<QPointF> &pos, const size_t oldFirstPoint, const size_t firstPoint) {
+	hideRemoved(pos, oldFirstPoint ? oldFirstPoint - 1 : 0, firstPoint);
+	markDirty();
+}
+
+/**
+ * @brief Moves the vertices of removed points out of sight
+ *
+ * The removed vertices stay in the triangle strip, but must not form visible triangles.
+ * All of them are moved onto the origin, except for the last one, which repeats the first remaining vertex.
+ * That way every triangle touching a removed vertex has two identical corners.
+ * @param pos All points of the Segment
+ * @param begin The first vertex to hide
+ * @param firstPoint The index of the first point in \a pos that was not removed yet
+ */
+void SegmentNode::hideRemoved(const std::vector<QPointF> &pos, const size_t begin, const size_t firstPoint) {
+	if (!firstPoint) {
+		return;
+	}
+	QSGGeometry::Point2D *vertices = geometry.vertexDataAsPoint2D();
+	for (size_t i = begin; i + 1 < firstPoint; ++i) {
+		vertices[i].set(0, 0);
+	}
+	vertices[firstPoint - 1].set(pos[firstPoint].x(), pos[firstPoint].y());
+}
+
+/**
+ * @brief Flags the geometry dirty for the renderer
+ */
+void SegmentNode::markDirty() {
+	geometry.markVertexDataDirty();
+	geoNode.markDirty(QSGNode::DirtyGeometry);
+}
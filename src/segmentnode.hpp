@@ -0,0 +1,40 @@
+#pragma once
+
+#include <QPointF>
+#include <QSGFlatColorMaterial>
+#include <QSGGeometry>
+#include <QSGGeometryNode>
+#include <vector>
+
+/**
+ * @brief The node rendering a Segment in the scene graph
+ *
+ * This is an optional observer of a Segment, it only exists if there is a scene graph to render into.
+ * The vertices mirror the points of the Segment, including the points that were already removed from the front.
+ * Removed vertices and spare capacity are placed such that they only form degenerate triangles.
+ */
+class SegmentNode {
+public:
+	explicit SegmentNode(QSGNode *parentNode, QSGFlatColorMaterial *material, const float thickness);
+	~SegmentNode();
+
+	void update(const std::vector<QPointF> &pos, const size_t firstPoint);
+	void append(const std::vector<QPointF> &pos, const size_t firstPoint, const size_t count);
+	void pop(const std::vector<QPointF> &pos, const size_t oldFirstPoint, const size_t firstPoint);
+private:
+	void hideRemoved(const std::vector<QPointF> &pos, const size_t begin, const size_t firstPoint);
+	void markDirty();
+
+	/**
+	 * @brief The parent node in the scene graph
+	 */
+	QSGNode *parentNode;
+	/**
+	 * @brief The node representing the Segment in the scene graph
+	 */
+	QSGGeometryNode geoNode;
+	/**
+	 * @brief The geometry of the Segment
+	 */
+	QSGGeometry geometry = QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+};
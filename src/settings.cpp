@@ -1,5 +1,7 @@
 #include "settings.hpp"
 
+#include <algorithm>
+
 /**
  * @brief Sets the dimension of the game
  * @param dimension The new dimension
@@ -24,8 +26,7 @@ QPoint Settings::getDimension() const {
  * @param width The new width
  */
 void Settings::setWidth(int width) {
-	dimension.setX(width);
-	setDimension(dimension);
+	setDimension({width, getHeight()});
 }
 
 /**
@@ -33,7 +34,7 @@ void Settings::setWidth(int width) {
  * @return The width
  */
 int Settings::getWidth() const {
-	return dimension.x();
+	return getDimension().x();
 }
 
 /**
@@ -41,8 +42,7 @@ int Settings::getWidth() const {
  * @param height The new height
  */
 void Settings::setHeight(int height) {
-	dimension.setY(height);
-	setDimension(dimension);
+	setDimension({getWidth(), height});
 }
 
 /**
@@ -50,7 +50,7 @@ void Settings::setHeight(int height) {
  * @return The height of the game
  */
 int Settings::getHeight() const {
-	return dimension.y();
+	return getDimension().y();
 }
 
 /**
@@ -165,6 +165,22 @@ unsigned Settings::getNetworkCurverBlock() const {
 	return networkCurverBlock;
 }
 
+/**
+ * @brief Sets the bandwidth budget of every Client
+ * @param bandwidth The new bandwidth in kilobytes per second
+ */
+void Settings::setNetworkBandwidth(const int bandwidth) {
+	networkBandwidth = bandwidth;
+}
+
+/**
+ * @brief Returns the bandwidth budget of every Client
+ * @return The bandwidth in kilobytes per second
+ */
+int Settings::getNetworkBandwidth() const {
+	return networkBandwidth;
+}
+
 /**
  * @brief Sets the amount of logic updates per second
  * @param val The new value
@@ -180,6 +196,49 @@ unsigned Settings::getUpdatesPerSecond() const {
 	return updatesPerSecond;
 }
 
+/**
+ * @brief Converts a duration into a number of simulation ticks
+ * @param msecs The duration in milliseconds
+ * @return The number of ticks at the current update rate, rounded up
+ */
+quint64 Settings::msecsToTicks(const int msecs) const {
+	return (static_cast<quint64>(std::max(msecs, 0)) * updatesPerSecond + 999) / 1000;
+}
+
+/**
+ * @brief Sets the interpolation delay of a Client
+ * @param delay The new delay in milliseconds
+ */
+void Settings::setInterpolationDelay(const int delay) {
+	interpolationDelay = delay;
+}
+
+/**
+ * @brief Returns the interpolation delay of a Client
+ * @return The delay in milliseconds
+ */
+int Settings::getInterpolationDelay() const {
+	return interpolationDelay;
+}
+
+/**
+ * @brief Sets the seed of the random generator
+ *
+ * The seed is applied, when the next game starts.
+ * @param seed The new seed
+ */
+void Settings::setSeed(const quint64 seed) {
+	this->seed = seed;
+}
+
+/**
+ * @brief Returns the seed of the random generator
+ * @return The seed
+ */
+quint64 Settings::getSeed() const {
+	return seed;
+}
+
 /**
  * @brief Returns whether the application is started headless
  * @return Whether the application is started offscreen
@@ -4,6 +4,8 @@
 #include <QGuiApplication>
 #include <QObject>
 #include <QPoint>
+#include <QRandomGenerator>
+#include <atomic>
 #include <quartz/macros.hpp>
 
 /**
@@ -39,8 +41,15 @@ public:
 	Q_INVOKABLE int getTargetScore() const;
 	Q_INVOKABLE void setNetworkCurverBlock(const unsigned val);
 	Q_INVOKABLE unsigned getNetworkCurverBlock() const;
+	Q_INVOKABLE void setNetworkBandwidth(const int bandwidth);
+	Q_INVOKABLE int getNetworkBandwidth() const;
 	Q_INVOKABLE void setUpdatesPerSecond(const unsigned val);
 	Q_INVOKABLE unsigned getUpdatesPerSecond() const;
+	quint64 msecsToTicks(const int msecs) const;
+	Q_INVOKABLE void setInterpolationDelay(const int delay);
+	Q_INVOKABLE int getInterpolationDelay() const;
+	void setSeed(const quint64 seed);
+	quint64 getSeed() const;
 	Q_INVOKABLE bool getOffscreen() const;
 signals:
 	/**
@@ -68,26 +77,28 @@ private:
 	QColor clientColor;
 	/**
 	 * @brief The dimension of the game
+	 *
+	 * This and the other settings that the simulation thread reads are atomic, because they are changed on the main thread.
 	 */
-	QPoint dimension {700, 836};
+	std::atomic<QPoint> dimension {QPoint(700, 836)};
 	/**
 	 * @brief The current round time out
 	 *
 	 * This is the amount of time that has to be waited for the next round, after the old one was finished
 	 */
-	int roundTimeOut = 1000;
+	std::atomic<int> roundTimeOut = 1000;
 	/**
 	 * @brief The minimum amount of time between two item spawns
 	 */
-	int itemSpawnIntervalMin = 1000;
+	std::atomic<int> itemSpawnIntervalMin = 1000;
 	/**
 	 * @brief The maximum amount of time between two item spawns
 	 */
-	int itemSpawnIntervalMax = 5000;
+	std::atomic<int> itemSpawnIntervalMax = 5000;
 	/**
 	 * @brief The score to achieve to win the game
 	 */
-	int targetScore = 15;
+	std::atomic<int> targetScore = 15;
 	/**
 	 * @brief Determines how often Curver data should be sent by the Server
 	 *
@@ -95,8 +106,26 @@ private:
 	 * A value of 1 means, that every iteration all data will be sent.
 	 */
 	unsigned networkCurverBlock = 2;
+	/**
+	 * @brief The bandwidth in kilobytes per second, that the Curver data sent to a single Client may use at most
+	 *
+	 * Clients that lose Curver data get less than that, see RateControl.
+	 */
+	int networkBandwidth = 16;
 	/**
 	 * @brief The number of logic updates per second
 	 */
-	unsigned updatesPerSecond = 60;
+	std::atomic<unsigned> updatesPerSecond = 60;
+	/**
+	 * @brief The time in milliseconds that a Client displays the Curvers behind the most recent data of the Server
+	 *
+	 * A larger delay hides more jitter and packet loss, see InterpolationBuffer.
+	 */
+	int interpolationDelay = 100;
+	/**
+	 * @brief The seed of the random generator of every game
+	 *
+	 * Unless it is set explicitly, every run of the application uses a different seed.
+	 */
+	quint64 seed = QRandomGenerator::global()->generate64();
 };
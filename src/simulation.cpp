@@ -0,0 +1,119 @@
+#include "simulation.hpp"
+
+#include <chrono>
+#include <mutex>
+
+#include "models/playermodel.hpp"
+#include "settings.hpp"
+
+// upper bound of ticks per call to advance(), so that a stall does not cause an endless catch-up
+#define MAX_TICKS_PER_ADVANCE 10
+
+/**
+ * @brief Constructs a Simulation
+ * @param step The game logic to run every tick, called with the tick length in milliseconds
+ */
+Simulation::Simulation(std::function<void(const float)> step)
+	: step(step) {
+}
+
+Simulation::~Simulation() {
+	stop();
+}
+
+/**
+ * @brief Starts the simulation, restarting it if it is already running
+ * @param threaded Whether to run the simulation on its own thread. Otherwise advance() must be called regularly.
+ */
+void Simulation::start(const bool threaded) {
+	stop();
+	simulatedTime = 0;
+	clock.start();
+	if (threaded) {
+		thread = std::jthread([this](std::stop_token stopToken) { run(stopToken); });
+	}
+}
+
+/**
+ * @brief Stops the simulation and its thread, if there is one
+ *
+ * This blocks until the current tick finished.
+ */
+void Simulation::stop() {
+	if (thread.joinable()) {
+		thread.request_stop();
+		thread.join();
+	}
+	clock.invalidate();
+}
+
+/**
+ * @brief Returns whether the simulation is running
+ * @return \c True, iif start() was called and stop() was not called since
+ */
+bool Simulation::isStarted() const {
+	return clock.isValid();
+}
+
+/**
+ * @brief Runs all ticks that are due according to the clock
+ *
+ * The remainder that does not make up a full tick is carried over to the next call.
+ */
+void Simulation::advance() {
+	const qint64 length = tickLength();
+	const qint64 now = clock.nsecsElapsed();
+	for (int i = 0; simulatedTime + length <= now; ++i) {
+		if (i == MAX_TICKS_PER_ADVANCE) {
+			// drop the backlog instead of trying to catch up forever
+			simulatedTime = now;
+			break;
+		}
+		{
+			std::scoped_lock lock(PlayerModel::get()->mutex);
+			step(length / 1000000.f);
+			snapshots.back().fill(++ticks, roundStartTick);
+		}
+		snapshots.publish();
+		simulatedTime += length;
+	}
+}
+
+/**
+ * @brief Marks the tick that is currently running as the start of a new round
+ *
+ * This must be called from within the step, so that the snapshot of the same tick carries the reset.
+ */
+void Simulation::startRound() {
+	roundStartTick = ticks + 1;
+}
+
+/**
+ * @brief Returns the snapshot of the most recent tick
+ *
+ * This never blocks, but must only be called from a single thread.
+ * @return The latest snapshot, which stays valid until the next call
+ */
+const Snapshot &Simulation::latestSnapshot() {
+	return snapshots.front();
+}
+
+/**
+ * @brief The main loop of the simulation thread
+ * @param stopToken The token that signals the thread to stop
+ */
+void Simulation::run(std::stop_token stopToken) {
+	while (!stopToken.stop_requested()) {
+		advance();
+		// sleep until the next tick is due
+		std::this_thread::sleep_for(std::chrono::nanoseconds(simulatedTime + tickLength() - clock.nsecsElapsed()));
+	}
+}
+
+/**
+ * @brief Returns the length of a single tick
+ * @return The tick length in nanoseconds
+ */
+qint64 Simulation::tickLength() const {
+	return 1000000000 / Settings::get()->getUpdatesPerSecond();
+}
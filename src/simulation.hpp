@@ -0,0 +1,67 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <atomic>
+#include <functional>
+#include <thread>
+
+#include "snapshot.hpp"
+#include "triplebuffer.hpp"
+
+/**
+ * @brief Drives the game logic in fixed timesteps and publishes a Snapshot after every tick
+ *
+ * The simulation either runs on a dedicated thread, or it is advanced manually by calling advance().
+ * The latter is needed, whenever the game logic touches nodes of a rendered scene graph, because these must only be changed inside of the render synchronization.
+ *
+ * Every tick holds PlayerModel::mutex, so that other threads can safely change the players in between ticks.
+ * The snapshots are handed off through a lock-free TripleBuffer, so reading them never blocks the simulation.
+ */
+class Simulation {
+public:
+	explicit Simulation(std::function<void(const float)> step);
+	~Simulation();
+
+	void start(const bool threaded);
+	void stop();
+	bool isStarted() const;
+	void advance();
+	void startRound();
+	const Snapshot &latestSnapshot();
+private:
+	void run(std::stop_token stopToken);
+	qint64 tickLength() const;
+
+	/**
+	 * @brief The game logic of a single tick, taking the tick length in milliseconds
+	 */
+	std::function<void(const float)> step;
+	/**
+	 * @brief The monotonic clock that the simulation follows, started with the simulation
+	 */
+	QElapsedTimer clock;
+	/**
+	 * @brief The amount of time in nanoseconds on Simulation::clock that was already simulated
+	 *
+	 * The difference to the clock is the accumulator of the fixed step loop.
+	 */
+	qint64 simulatedTime = 0;
+	/**
+	 * @brief The number of ticks simulated so far
+	 *
+	 * This keeps counting across restarts, so a tick number identifies a snapshot for as long as the Simulation lives.
+	 */
+	quint64 ticks = 0;
+	/**
+	 * @brief The number of the tick that started the current round, see Snapshot::roundStartTick
+	 */
+	quint64 roundStartTick = 0;
+	/**
+	 * @brief The snapshots handed off to the consumer
+	 */
+	TripleBuffer<Snapshot> snapshots;
+	/**
+	 * @brief The dedicated simulation thread, if the simulation is threaded
+	 */
+	std::jthread thread;
+};
@@ -0,0 +1,26 @@
+#include "snapshot.hpp"
+
+#include "models/playermodel.hpp"
+
+/**
+ * @brief Fills the snapshot with the current state of every Curver
+ *
+ * Existing allocations are reused, so filling a recycled snapshot does not allocate in the common case.
+ * @param tick The number of the tick that just finished
+ * @param roundStartTick The number of the tick that started the current round
+ */
+void Snapshot::fill(const quint64 tick, const quint64 roundStartTick) {
+	this->tick = tick;
+	this->roundStartTick = roundStartTick;
+	const auto &curvers = PlayerModel::get()->getCurvers();
+	positions.resize(curvers.size());
+	changingSegment.resize(curvers.size());
+	motions.resize(curvers.size());
+	inputSequences.resize(curvers.size());
+	for (size_t i = 0; i < curvers.size(); ++i) {
+		positions[i] = curvers[i]->getPos();
+		changingSegment[i] = curvers[i]->isChangingSegment();
+		motions[i] = curvers[i]->getMotion();
+		inputSequences[i] = curvers[i]->inputSequence;
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QPointF>
+#include <QtGlobal>
+#include <vector>
+
+#include "curver.hpp"
+
+/**
+ * @brief An immutable copy of the game state after a single simulation tick
+ *
+ * Snapshots are published by the Simulation, so that other threads can read a consistent state without touching the live game objects.
+ */
+struct Snapshot {
+	void fill(const quint64 tick, const quint64 roundStartTick);
+
+	/**
+	 * @brief The number of the simulation tick that produced this snapshot, or \c 0 if there was none yet
+	 */
+	quint64 tick = 0;
+	/**
+	 * @brief The number of the tick that started the current round, or \c 0 if no round was reset yet
+	 *
+	 * This is carried along by every snapshot, so a consumer that skips snapshots still notices the reset in order with the state of the new round.
+	 */
+	quint64 roundStartTick = 0;
+	/**
+	 * @brief The head position of every Curver
+	 *
+	 * Every tick appends at most one point per Curver, so this is also the delta of all segments since the previous tick.
+	 */
+	std::vector<QPointF> positions;
+	/**
+	 * @brief Whether an individual Curver is changing segments, i.e. whether its position was not appended to a segment
+	 */
+	std::vector<bool> changingSegment;
+	/**
+	 * @brief The motion of every Curver, which a Client needs to predict its own Curver
+	 */
+	std::vector<Curver::Motion> motions;
+	/**
+	 * @brief The sequence number of the last input applied to every Curver, see Curver::inputSequence
+	 */
+	std::vector<quint32> inputSequences;
+};
@@ -0,0 +1,168 @@
+#include "spatialgrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "segment.hpp"
+
+#define GRID_CELL_SIZE 32.0
+// safety margin around every edge and query line, must be larger than Intersection::epsilon
+#define GRID_MARGIN 1.0
+
+SpatialGrid::SpatialGrid() {
+	cells.resize(1);
+}
+
+/**
+ * @brief Resizes the grid to cover the given arena dimension and removes all entries
+ * @param dimension The dimension of the game arena
+ *
+ * Positions outside of the arena are mapped to the border cells, so the grid stays correct, even if the dimension changes later on.
+ */
+void SpatialGrid::reset(const QPoint dimension) {
+	columns = std::max(1, static_cast<int>(std::ceil(dimension.x() / GRID_CELL_SIZE)));
+	rows = std::max(1, static_cast<int>(std::ceil(dimension.y() / GRID_CELL_SIZE)));
+	cells.assign(static_cast<size_t>(columns) * rows, {});
+}
+
+/**
+ * @brief Removes all entries while keeping the allocated cells
+ */
+void SpatialGrid::clear() {
+	std::ranges::for_each(cells, [](auto &c) { c.clear(); });
+}
+
+/**
+ * @brief Registers an edge of a Segment in every cell that it covers
+ * @param segment The Segment owning the edge
+ * @param edge The index of the edge inside of \a segment
+ * @param c The start point of the edge
+ * @param d The end point of the edge
+ */
+void SpatialGrid::insertEdge(const Segment *segment, const size_t edge, const QPointF c, const QPointF d) {
+	const QRect rect = cellsCovering(c, d);
+	for (int y = rect.top(); y <= rect.bottom(); ++y) {
+		for (int x = rect.left(); x <= rect.right(); ++x) {
+			auto &entries = cell(x, y);
+			// edges arrive in order, so we can usually just extend the last range
+			if (!entries.empty() && entries.back().segment == segment && entries.back().last + 2 >= edge) {
+				entries.back().last = std::max(entries.back().last, edge);
+			} else {
+				entries.push_back({segment, edge, edge});
+			}
+		}
+	}
+}
+
+/**
+ * @brief Removes all entries of a Segment
+ * @param segment The Segment to remove
+ * @param cellRect The cells that \a segment was registered in
+ */
+void SpatialGrid::remove(const Segment *segment, const QRect cellRect) {
+	for (int y = cellRect.top(); y <= cellRect.bottom(); ++y) {
+		for (int x = cellRect.left(); x <= cellRect.right(); ++x) {
+			std::erase_if(cell(x, y), [=](const auto &e) { return e.segment == segment; });
+		}
+	}
+}
+
+/**
+ * @brief Checks if any registered edge collides with a line from a to b
+ * @param a The start point of the line
+ * @param b The end point of the line
+ * @return \c True, iif any edge intersects with the line a -> b
+ *
+ * Only the cells that the line passes through are visited.
+ * The line is walked column by column, and in each column only the rows that the line covers inside of that column are checked.
+ */
+bool SpatialGrid::checkForIntersection(QPointF a, QPointF b) const {
+	const QPointF left = a.x() <= b.x() ? a : b;
+	const QPointF right = a.x() <= b.x() ? b : a;
+	const qreal minY = std::min(a.y(), b.y()) - GRID_MARGIN;
+	const qreal maxY = std::max(a.y(), b.y()) + GRID_MARGIN;
+	const qreal dx = right.x() - left.x();
+	const int lastColumn = column(right.x() + GRID_MARGIN);
+	for (int x = column(left.x() - GRID_MARGIN); x <= lastColumn; ++x) {
+		qreal lower = minY;
+		qreal upper = maxY;
+		if (dx > 0) {
+			// the border columns also cover everything outside of the arena
+			const qreal columnStart = x == 0 ? left.x() : x * GRID_CELL_SIZE - GRID_MARGIN;
+			const qreal columnEnd = x == columns - 1 ? right.x() : (x + 1) * GRID_CELL_SIZE + GRID_MARGIN;
+			const qreal x0 = std::clamp(columnStart, left.x(), right.x());
+			const qreal x1 = std::clamp(columnEnd, left.x(), right.x());
+			const qreal y0 = left.y() + (right.y() - left.y()) * (x0 - left.x()) / dx;
+			const qreal y1 = left.y() + (right.y() - left.y()) * (x1 - left.x()) / dx;
+			lower = std::max(minY, std::min(y0, y1) - GRID_MARGIN);
+			upper = std::min(maxY, std::max(y0, y1) + GRID_MARGIN);
+		}
+		const int lastRow = row(upper);
+		for (int y = row(lower); y <= lastRow; ++y) {
+			if (checkCell(cell(x, y), a, b)) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief Returns the cells covered by an edge
+ * @param c The start point of the edge
+ * @param d The end point of the edge
+ * @return The covered cells, where each cell is one unit in the returned rectangle
+ */
+QRect SpatialGrid::cellsCovering(const QPointF c, const QPointF d) const {
+	return QRect(QPoint(column(std::min(c.x(), d.x()) - GRID_MARGIN), row(std::min(c.y(), d.y()) - GRID_MARGIN)),
+		QPoint(column(std::max(c.x(), d.x()) + GRID_MARGIN), row(std::max(c.y(), d.y()) + GRID_MARGIN)));
+}
+
+/**
+ * @brief Returns the column containing a given x coordinate
+ * @param x The x coordinate
+ * @return The column, clamped to the grid
+ */
+int SpatialGrid::column(const qreal x) const {
+	return static_cast<int>(std::clamp(std::floor(x / GRID_CELL_SIZE), 0.0, columns - 1.0));
+}
+
+/**
+ * @brief Returns the row containing a given y coordinate
+ * @param y The y coordinate
+ * @return The row, clamped to the grid
+ */
+int SpatialGrid::row(const qreal y) const {
+	return static_cast<int>(std::clamp(std::floor(y / GRID_CELL_SIZE), 0.0, rows - 1.0));
+}
+
+/**
+ * @brief Returns a cell
+ * @param x The column of the cell
+ * @param y The row of the cell
+ * @return The entries stored in the cell
+ */
+std::vector<SpatialGrid::Entry> &SpatialGrid::cell(const int x, const int y) {
+	return cells[static_cast<size_t>(y) * columns + x];
+}
+
+/**
+ * @brief Returns a cell
+ * @param x The column of the cell
+ * @param y The row of the cell
+ * @return The entries stored in the cell
+ */
+const std::vector<SpatialGrid::Entry> &SpatialGrid::cell(const int x, const int y) const {
+	return cells[static_cast<size_t>(y) * columns + x];
+}
+
+/**
+ * @brief Checks all entries of a cell for a collision with the line from a to b
+ * @param entries The entries of the cell
+ * @param a The start point of the line
+ * @param b The end point of the line
+ * @return \c True, iif any edge in the cell intersects with the line
+ */
+bool SpatialGrid::checkCell(const std::vector<Entry> &entries, QPointF a, QPointF b) const {
+	return std::ranges::any_of(entries, [&](const auto &e) { return e.segment->checkForIntersection(a, b, e.first, e.last); });
+}
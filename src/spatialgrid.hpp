@@ -0,0 +1,67 @@
+#pragma once
+
+#include <QPoint>
+#include <QPointF>
+#include <QRect>
+#include <vector>
+
+class Segment;
+
+/**
+ * @brief A uniform grid over the game arena that indexes trail edges by location
+ *
+ * Every Segment registers its edges in the cells that they cover.
+ * Collision queries then only test the edges stored in the cells that the query line passes through,
+ * which keeps the cost of a query independent of the total trail length.
+ *
+ * Consecutive edges of the same Segment that fall into the same cell are merged into a single entry,
+ * so each cell only stores a few edge ranges.
+ */
+class SpatialGrid {
+public:
+	explicit SpatialGrid();
+
+	void reset(const QPoint dimension);
+	void clear();
+	void insertEdge(const Segment *segment, const size_t edge, const QPointF c, const QPointF d);
+	void remove(const Segment *segment, const QRect cellRect);
+	bool checkForIntersection(QPointF a, QPointF b) const;
+	QRect cellsCovering(const QPointF c, const QPointF d) const;
+private:
+	/**
+	 * @brief A range of consecutive edges of a Segment stored in a cell
+	 */
+	struct Entry {
+		/**
+		 * @brief The Segment owning the edges
+		 */
+		const Segment *segment;
+		/**
+		 * @brief The first edge index in the range
+		 */
+		size_t first;
+		/**
+		 * @brief The last edge index in the range (inclusive)
+		 */
+		size_t last;
+	};
+
+	int column(const qreal x) const;
+	int row(const qreal y) const;
+	std::vector<Entry> &cell(const int x, const int y);
+	const std::vector<Entry> &cell(const int x, const int y) const;
+	bool checkCell(const std::vector<Entry> &entries, QPointF a, QPointF b) const;
+
+	/**
+	 * @brief The number of columns in the grid
+	 */
+	int columns = 1;
+	/**
+	 * @brief The number of rows in the grid
+	 */
+	int rows = 1;
+	/**
+	 * @brief All cells stored row by row
+	 */
+	std::vector<std::vector<Entry>> cells;
+};
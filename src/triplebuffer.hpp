@@ -0,0 +1,74 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief A lock-free triple buffer to hand off values from one producer thread to one consumer thread
+ *
+ * The producer writes into back() and then calls publish(), the consumer reads the most recently published value with front().
+ * Neither side ever waits for the other one, the producer may overwrite values that the consumer never saw.
+ * Values are reused in a round-robin fashion, so their allocations survive across publications.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+	/**
+	 * @brief Returns the value that the producer is currently writing
+	 *
+	 * Must only be called from the producer thread.
+	 * @return The back value
+	 */
+	T &back() {
+		return buffers[backIndex];
+	}
+
+	/**
+	 * @brief Publishes the back value to the consumer
+	 *
+	 * Must only be called from the producer thread. Afterwards back() refers to a different value with unspecified contents.
+	 */
+	void publish() {
+		backIndex = middle.exchange(backIndex | FRESH_BIT, std::memory_order_acq_rel) & INDEX_MASK;
+	}
+
+	/**
+	 * @brief Returns the most recently published value
+	 *
+	 * Must only be called from the consumer thread. The returned reference stays valid until the next call.
+	 * @return The front value
+	 */
+	const T &front() {
+		if (middle.load(std::memory_order_relaxed) & FRESH_BIT) {
+			frontIndex = middle.exchange(frontIndex, std::memory_order_acq_rel) & INDEX_MASK;
+		}
+		return buffers[frontIndex];
+	}
+private:
+	/**
+	 * @brief Set in TripleBuffer::middle, if the middle value was published, but not consumed yet
+	 */
+	static constexpr uint8_t FRESH_BIT = 4;
+	/**
+	 * @brief Extracts the buffer index from TripleBuffer::middle
+	 */
+	static constexpr uint8_t INDEX_MASK = 3;
+
+	/**
+	 * @brief The three values
+	 */
+	std::array<T, 3> buffers;
+	/**
+	 * @brief The index of the value owned by the producer
+	 */
+	uint8_t backIndex = 0;
+	/**
+	 * @brief The index of the value that is exchanged between both threads, plus the TripleBuffer::FRESH_BIT
+	 */
+	std::atomic<uint8_t> middle = 1;
+	/**
+	 * @brief The index of the value owned by the consumer
+	 */
+	uint8_t frontIndex = 2;
+};
@@ -1,44 +1,7 @@
 #include "util.hpp"
 
-#include <QRandomGenerator>
 #include <math.h>
 
-/**
- * @brief Returns a random number between 0 and 1
- * @return A random number between 0 and 1
- */
-double Util::rand() {
-	return QRandomGenerator::global()->generateDouble();
-}
-
-/**
- * @brief Returns a random QPointF with values between 0 and 1 each
- * @return A random QPointF
- */
-QPointF Util::randQPointF() {
-	return QPointF(rand(), rand());
-}
-
-/**
- * @brief Returns a random integer in the given range
- * @param lower Lower boundary
- * @param upper Upper boundary
- * @return A random integer in the given range
- */
-int Util::randInt(const int lower, const int upper) {
-	return lower + rand() * (upper - lower);
-}
-
-/**
- * @brief Returns a random Material design color
- * @return A random color
- */
-QColor Util::randColor() {
-	auto it = colors.begin();
-	std::advance(it, randInt(0, static_cast<int>(colors.size()) - 1));
-	return it->second;
-}
-
 /**
  * @brief Returns a Material design color
  * @param color The color to look up
@@ -85,3 +48,60 @@ qint64 Util::getTimeDiff(const QTime &t) {
 float Util::easeInOutSine(const float &a) {
 	return 0.5 * (1 - std::cos(M_PI * a));
 }
+
+/**
+ * @brief Serializes an unsigned integer with as few bytes as possible
+ *
+ * Every byte carries 7 bits of the value starting with the lowest ones, the highest bit marks that another byte follows.
+ * @param out The stream to serialize into
+ * @param value The value to serialize
+ */
+void Util::serializeVarint(QDataStream &out, quint64 value) {
+	while (value >= 0x80) {
+		out << static_cast<uint8_t>(value | 0x80);
+		value >>= 7;
+	}
+	out << static_cast<uint8_t>(value);
+}
+
+/**
+ * @brief Parses an unsigned integer serialized with serializeVarint()
+ *
+ * If the stream ends early or the value does not fit into 64 bits, the status of \a in indicates the failure.
+ * @param in The stream to parse from
+ * @return The parsed value
+ */
+quint64 Util::parseVarint(QDataStream &in) {
+	quint64 result = 0;
+	for (int shift = 0; shift < 64; shift += 7) {
+		uint8_t byte = 0;
+		in >> byte;
+		result |= static_cast<quint64>(byte & 0x7F) << shift;
+		if (!(byte & 0x80) || in.status() != QDataStream::Ok) {
+			return result;
+		}
+	}
+	in.setStatus(QDataStream::ReadCorruptData);
+	return result;
+}
+
+/**
+ * @brief Serializes a signed integer with as few bytes as possible
+ *
+ * The value is zigzag encoded first, so that values close to zero need few bytes no matter their sign.
+ * @param out The stream to serialize into
+ * @param value The value to serialize
+ */
+void Util::serializeZigzag(QDataStream &out, const qint64 value) {
+	serializeVarint(out, (static_cast<quint64>(value) << 1) ^ static_cast<quint64>(value >> 63));
+}
+
+/**
+ * @brief Parses a signed integer serialized with serializeZigzag()
+ * @param in The stream to parse from
+ * @return The parsed value
+ */
+qint64 Util::parseZigzag(QDataStream &in) {
+	const quint64 value = parseVarint(in);
+	return static_cast<qint64>(value >> 1) ^ -static_cast<qint64>(value & 1);
+}
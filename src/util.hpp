@@ -15,10 +15,6 @@
  * @brief Contains frequently used useful routines that are available for every class
  */
 namespace Util {
-double rand();
-QPointF randQPointF();
-int randInt(const int lower, const int upper);
-QColor randColor();
 const QColor getColor(const QString color);
 /**
 	 * @brief Material design colors
@@ -47,6 +43,10 @@ bool getBit(const uint8_t byte, const int pos);
 void setBit(uint8_t &byte, const int pos, bool value);
 qint64 getTimeDiff(const QTime &t);
 float easeInOutSine(const float &a);
+void serializeVarint(QDataStream &out, quint64 value);
+quint64 parseVarint(QDataStream &in);
+void serializeZigzag(QDataStream &out, const qint64 value);
+qint64 parseZigzag(QDataStream &in);
 
 // std algorithm wrappers
 
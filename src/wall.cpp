@@ -16,10 +16,12 @@ Wall::Wall() {
 
 /**
  * @brief Sets the parent node in the scene graph
- * @param parentNode The new parent node
+ * @param parentNode The new parent node, or \c nullptr to not render the Wall
  */
 void Wall::setParentNode(QSGNode *parentNode) {
-	parentNode->appendChildNode(&geoNode);
+	if (parentNode) {
+		parentNode->appendChildNode(&geoNode);
+	}
 }
 
 /**